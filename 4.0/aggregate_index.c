@@ -0,0 +1,286 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "data_struct.h"
+#include "player_store.h"
+#include "team_pool.h"
+#include "aggregate_index.h"
+
+#define BUCKET_COUNT (AGGREGATE_VALUE_LIMIT + 2)     /* ˵Ͱ */
+
+/*
+ * ֵͰĳֶȡͬһֵԱ
+ */
+typedef struct ValueBucket {
+    PlayerHandle* handles;      /* Ͱھ */
+    int count;                  /* Ͱ */
+    int capacity;               /*  */
+} ValueBucket;
+
+/*
+ * ֵͰĶؼϣlowest/highestΪ͡ߵķǿͰΪʱlowest > highest
+ */
+typedef struct ValueSet {
+    ValueBucket buckets[BUCKET_COUNT];
+    int* handle_position;       /*  -> Ͱе± */
+    int lowest, highest;
+} ValueSet;
+
+static Aggregate league;                        /*  */
+static Aggregate* teams = NULL;                 /* ӻܣ±꼴ӱ */
+static int team_capacity = 0;                   /* ӻ */
+static ValueSet value_sets[AGGREGATE_FIELD_COUNT] = {
+    {{{NULL, 0, 0}}, NULL, BUCKET_COUNT, -1},
+    {{{NULL, 0, 0}}, NULL, BUCKET_COUNT, -1}
+};
+static int handle_capacity = 0;                 /* handle_position */
+static const Aggregate empty_aggregate;         /* ûԱʱĻ */
+
+/*
+ * field_value / bucket_of
+ * ܣȡü¼ĳֵֶԼֵڵͰ0BUCKET_COUNT-1ΪͰ
+ */
+static int field_value(const Player* player, int field) {
+    return field == AGGREGATE_HEIGHT ? player->height : player->weight;
+}
+
+static int bucket_of(int value) {
+    if (value < 0) return 0;
+    if (value >= AGGREGATE_VALUE_LIMIT) return BUCKET_COUNT - 1;
+    return value + 1;
+}
+
+/*
+ * reserve_teams
+ * ܣ֤ӻ±team_idΪȫ0
+ */
+static int reserve_teams(int team_id) {
+    if (team_id < team_capacity) return 1;
+    int new_capacity = team_capacity > 0 ? team_capacity : 16;
+    while (new_capacity <= team_id) {
+        new_capacity *= 2;
+    }
+    Aggregate* grown = (Aggregate*)realloc(teams, (size_t)new_capacity * sizeof(Aggregate));
+    if (grown == NULL) return 0;
+    memset(&grown[team_capacity], 0, (size_t)(new_capacity - team_capacity) * sizeof(Aggregate));
+    teams = grown;
+    team_capacity = new_capacity;
+    return 1;
+}
+
+/*
+ * reserve_handles
+ * ܣ֤ӳ±handle
+ */
+static int reserve_handles(PlayerHandle handle) {
+    if (handle < handle_capacity) return 1;
+    int new_capacity = handle_capacity > 0 ? handle_capacity : 64;
+    while (new_capacity <= handle) {
+        new_capacity *= 2;
+    }
+    for (int f = 0; f < AGGREGATE_FIELD_COUNT; f++) {
+        int* grown = (int*)realloc(value_sets[f].handle_position, (size_t)new_capacity * sizeof(int));
+        if (grown == NULL) return 0;
+        value_sets[f].handle_position = grown;
+    }
+    handle_capacity = new_capacity;
+    return 1;
+}
+
+/*
+ * set_insert
+ * ܣѾؼֵڵͰ
+ * ֵ1ʾɹ0ʾڴ治
+ */
+static int set_insert(ValueSet* set, int value, PlayerHandle handle) {
+    int b = bucket_of(value);
+    ValueBucket* bucket = &set->buckets[b];
+    if (bucket->count == bucket->capacity) {    /* Ͱ */
+        int new_capacity = bucket->capacity > 0 ? bucket->capacity * 2 : 8;
+        PlayerHandle* grown = (PlayerHandle*)realloc(bucket->handles,
+                                                     (size_t)new_capacity * sizeof(PlayerHandle));
+        if (grown == NULL) return 0;
+        bucket->handles = grown;
+        bucket->capacity = new_capacity;
+    }
+    set->handle_position[handle] = bucket->count;
+    bucket->handles[bucket->count++] = handle;
+    if (b < set->lowest) set->lowest = b;
+    if (b > set->highest) set->highest = b;
+    return 1;
+}
+
+/*
+ * set_remove
+ * ܣѾֵڵͰƳͰĩβľλ
+ * 㷨O(1)ƳͣߣǿͰһʱѰһǿͰ
+ *       Ͱ̶AGGREGATE_VALUE_LIMIT+2
+ */
+static void set_remove(ValueSet* set, int value, PlayerHandle handle) {
+    int b = bucket_of(value);
+    ValueBucket* bucket = &set->buckets[b];
+    int position = set->handle_position[handle];
+    PlayerHandle moved = bucket->handles[--bucket->count];
+    bucket->handles[position] = moved;
+    set->handle_position[moved] = position;
+    if (bucket->count > 0) {
+        return;
+    }
+    while (set->lowest <= set->highest && set->buckets[set->lowest].count == 0) {
+        set->lowest++;
+    }
+    while (set->highest >= set->lowest && set->buckets[set->highest].count == 0) {
+        set->highest--;
+    }
+    if (set->lowest > set->highest) {
+        set->lowest = BUCKET_COUNT;             /* ѿ */
+        set->highest = -1;
+    }
+}
+
+/*
+ * add_to / subtract_from
+ * ܣһԱ۳һ
+ */
+static void add_to(Aggregate* aggregate, const Player* player) {
+    aggregate->count++;
+    aggregate->total_height += player->height;
+    aggregate->total_weight += player->weight;
+    aggregate->total_jersey += player->jersey;
+    if (player->position < POSITION_COUNT) {
+        aggregate->position_counts[player->position]++;
+    }
+}
+
+static void subtract_from(Aggregate* aggregate, const Player* player) {
+    aggregate->count--;
+    aggregate->total_height -= player->height;
+    aggregate->total_weight -= player->weight;
+    aggregate->total_jersey -= player->jersey;
+    if (player->position < POSITION_COUNT) {
+        aggregate->position_counts[player->position]--;
+    }
+}
+
+/*
+ * aggregate_index_insert
+ * ܣһԱӵĻ
+ * player - ¼, handle - ¼
+ * ֵ1ʾɹ0ʾڴ治ӱŷǷܲ䣩
+ */
+int aggregate_index_insert(const Player* player, PlayerHandle handle) {
+    if (player->team_id >= team_pool_count()) return 0;   /* ŷǷ */
+    if (!reserve_handles(handle) || !reserve_teams(player->team_id)) return 0;
+    if (!set_insert(&value_sets[AGGREGATE_HEIGHT], player->height, handle)) return 0;
+    if (!set_insert(&value_sets[AGGREGATE_WEIGHT], player->weight, handle)) {
+        set_remove(&value_sets[AGGREGATE_HEIGHT], player->height, handle);   /* ߷Ͱ */
+        return 0;
+    }
+    add_to(&league, player);
+    add_to(&teams[player->team_id], player);
+    return 1;
+}
+
+/*
+ * aggregate_index_remove
+ * ܣһԱӻп۳
+ * player - ¼Ǽʱͬ, handle - ¼
+ */
+void aggregate_index_remove(const Player* player, PlayerHandle handle) {
+    set_remove(&value_sets[AGGREGATE_HEIGHT], player->height, handle);
+    set_remove(&value_sets[AGGREGATE_WEIGHT], player->weight, handle);
+    subtract_from(&league, player);
+    subtract_from(&teams[player->team_id], player);
+}
+
+/*
+ * aggregate_index_league
+ * ܣȡ
+ * ֵ
+ */
+const Aggregate* aggregate_index_league(void) {
+    return &league;
+}
+
+/*
+ * aggregate_index_team
+ * ܣȡӻ
+ * team_id - ӱ
+ * ֵ֣ŷǷöӴδԱʱΪȫ0
+ */
+const Aggregate* aggregate_index_team(int team_id) {
+    if (team_id < 0 || team_id >= team_capacity) {
+        return &empty_aggregate;
+    }
+    return &teams[team_id];
+}
+
+/*
+ * aggregate_index_extreme
+ * ܣȡĳֶСһԱ
+ * field - ֶ, want_max - 1ȡ0ȡС
+ * ֵԱûԱʱINVALID_PLAYER_HANDLE
+ * ˵ͨͰڸ˵ֱֵͬȡһˣͰȽ
+ */
+PlayerHandle aggregate_index_extreme(AggregateField field, int want_max) {
+    const ValueSet* set = &value_sets[field];
+    if (set->lowest > set->highest) {
+        return INVALID_PLAYER_HANDLE;
+    }
+    int b = want_max ? set->highest : set->lowest;
+    const ValueBucket* bucket = &set->buckets[b];
+    PlayerHandle best = bucket->handles[0];
+    if (b == 0 || b == BUCKET_COUNT - 1) {
+        int best_value = field_value(player_store_get(best), field);
+        for (int i = 1; i < bucket->count; i++) {
+            int value = field_value(player_store_get(bucket->handles[i]), field);
+            if (want_max ? value > best_value : value < best_value) {
+                best_value = value;
+                best = bucket->handles[i];
+            }
+        }
+    }
+    return best;
+}
+
+/*
+ * aggregate_index_rebuild
+ * ܣջܲǰ洢ؽ
+ * ֵӱԽųplayer_store_excludedļ¼ڴ治㷵-1
+ */
+int aggregate_index_rebuild(void) {
+    aggregate_index_release();
+    int skipped = 0;                            /* ļ¼ */
+    for (int i = 0; i < player_store.count; i++) {
+        if (player_store_excluded(i) || player_store.records[i].team_id >= team_pool_count()) {
+            skipped++;                          /* ֻӳļ */
+            continue;
+        }
+        if (!aggregate_index_insert(&player_store.records[i], player_store_handle_at(i))) {
+            return -1;
+        }
+    }
+    return skipped;
+}
+
+/*
+ * aggregate_index_release
+ * ܣͷŻռõȫڴ
+ */
+void aggregate_index_release(void) {
+    for (int f = 0; f < AGGREGATE_FIELD_COUNT; f++) {
+        ValueSet* set = &value_sets[f];
+        for (int b = 0; b < BUCKET_COUNT; b++) {
+            free(set->buckets[b].handles);
+        }
+        free(set->handle_position);
+        memset(set, 0, sizeof(ValueSet));
+        set->lowest = BUCKET_COUNT;
+        set->highest = -1;
+    }
+    free(teams);
+    teams = NULL;
+    team_capacity = 0;
+    handle_capacity = 0;
+    memset(&league, 0, sizeof(league));
+}
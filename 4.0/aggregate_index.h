@@ -0,0 +1,99 @@
+#ifndef AGGREGATE_INDEX_H
+#define AGGREGATE_INDEX_H
+
+#include <stdint.h>
+#include "data_struct.h"
+#include "player_store.h"
+
+/*
+ * ͳƻģ
+ * ÿɾͬӵĻ֣ܺ͡λ÷ֲ
+ * ߡصֵԱͰؼϣɾֵԱԿֱȡµļֵ
+ * ͳƱӷֱӶȡܽʱ޹ء
+ * ͰΧΪ[0, AGGREGATE_VALUE_LIMIT)Χֵֻδ֤ľļ
+ * ˵ͰȡֵʱͰȽϡ
+ */
+
+#define AGGREGATE_VALUE_LIMIT 512        /* ߡذֵͰϽ磨 */
+
+/*
+ * Ͱֶ
+ */
+typedef enum AggregateField {
+    AGGREGATE_HEIGHT = 0,   /*  */
+    AGGREGATE_WEIGHT = 1,   /*  */
+    AGGREGATE_FIELD_COUNT = 2
+} AggregateField;
+
+/*
+ * һԱĻ
+ */
+typedef struct Aggregate {
+    int count;                              /*  */
+    int64_t total_height;                   /* ܺ */
+    int64_t total_weight;                   /* ܺ */
+    int64_t total_jersey;                   /* ºܺ */
+    int position_counts[POSITION_COUNT];    /* λǷλò */
+} Aggregate;
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * aggregate_index_insert
+ * ܣһԱӵĻ
+ * player - ¼, handle - ¼
+ * ֵ1ʾɹ0ʾڴ治ӱŷǷܲ䣩
+ */
+int aggregate_index_insert(const Player* player, PlayerHandle handle);
+
+/*
+ * aggregate_index_remove
+ * ܣһԱӻп۳ڼ¼޸Ļɾ֮ǰã
+ * player - ¼Ǽʱͬ, handle - ¼
+ */
+void aggregate_index_remove(const Player* player, PlayerHandle handle);
+
+/*
+ * aggregate_index_league
+ * ܣȡ
+ * 
+ * ֵ֣һɾǰЧ
+ */
+const Aggregate* aggregate_index_league(void);
+
+/*
+ * aggregate_index_team
+ * ܣȡӻ
+ * team_id - ӱ
+ * ֵ֣ŷǷöӴδԱʱΪȫ0
+ */
+const Aggregate* aggregate_index_team(int team_id);
+
+/*
+ * aggregate_index_extreme
+ * ܣȡĳֶСһԱ
+ * field - ֶ, want_max - 1ȡ0ȡС
+ * ֵԱֵͬʱΪһûԱʱINVALID_PLAYER_HANDLE
+ * ʱ临ӶȣO(1)
+ */
+PlayerHandle aggregate_index_extreme(AggregateField field, int want_max);
+
+/*
+ * aggregate_index_rebuild
+ * ܣջܲǰ洢ؽ
+ * 
+ * ֵӱԽųplayer_store_excludedļ¼ڴ治㷵-1
+ */
+int aggregate_index_rebuild(void);
+
+/*
+ * aggregate_index_release
+ * ܣͷŻռõȫڴ
+ * 
+ */
+void aggregate_index_release(void);
+
+#endif /* AGGREGATE_INDEX_H */
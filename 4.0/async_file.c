@@ -0,0 +1,259 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+#include "async_file.h"
+
+/*
+ * 򿪵ļ󰴷˳ʹø黺kʹõk % ASYNC_FILE_DEPTH飬
+ * ;ǵcompleted % ASYNC_FILE_DEPTH
+ */
+struct AsyncFile {
+    HANDLE handle;                              /* ļ */
+    int writing;                                /* 1ʾд뷽ʽ */
+    int overlapped;                             /* 1ʾصʽ򿪣0ʾ˻ͨλд */
+    int failed;                                 /* 1ʾʧ */
+    size_t block_size;                          /* ÿֽ */
+    unsigned char* buffers;                     /* ȫ */
+    OVERLAPPED requests[ASYNC_FILE_DEPTH];      /* 󣨺ƫ¼ */
+    DWORD sizes[ASYNC_FILE_DEPTH];              /* ֽ */
+    DWORD done_bytes[ASYNC_FILE_DEPTH];         /* ɵʵʶдֽ */
+    int done[ASYNC_FILE_DEPTH];                 /* 1ʾ󵱳ɣصȴ */
+    int issued;                                 /* ѷ */
+    int completed;                              /* ѵȵ */
+    uint64_t position;                          /* һļƫ */
+    uint64_t end;                               /* ȡĽƫ */
+    size_t filled;                              /* д룺ǰдֽ */
+};
+
+/*
+ * block_of
+ * ܣȡõslot黺
+ */
+static unsigned char* block_of(AsyncFile* file, int slot) {
+    return file->buffers + (size_t)slot * file->block_size;
+}
+
+/*
+ * open_file
+ * ܣļ仺¼޷صʽʱΪͨʽ
+ */
+static AsyncFile* open_file(const char* path, int writing, size_t block_size) {
+    AsyncFile* file = (AsyncFile*)calloc(1, sizeof(AsyncFile));
+    if (file == NULL) {
+        return NULL;
+    }
+    file->writing = writing;
+    file->block_size = block_size > 0 ? block_size : 1;
+    file->buffers = (unsigned char*)malloc(file->block_size * ASYNC_FILE_DEPTH);
+    int ok = file->buffers != NULL;
+    for (int i = 0; ok && i < ASYNC_FILE_DEPTH; i++) {
+        file->requests[i].hEvent = CreateEventA(NULL, TRUE, FALSE, NULL);   /* ÿһ¼ */
+        ok = file->requests[i].hEvent != NULL;
+    }
+    
+    DWORD access = writing ? GENERIC_WRITE : GENERIC_READ;
+    DWORD disposition = writing ? CREATE_ALWAYS : OPEN_EXISTING;
+    file->handle = INVALID_HANDLE_VALUE;
+    if (ok) {
+        file->handle = CreateFileA(path, access, FILE_SHARE_READ, NULL, disposition,
+                                   FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, NULL);
+        file->overlapped = file->handle != INVALID_HANDLE_VALUE;
+        if (!file->overlapped) {
+            file->handle = CreateFileA(path, access, FILE_SHARE_READ, NULL, disposition,
+                                       FILE_ATTRIBUTE_NORMAL, NULL);
+        }
+    }
+    if (file->handle == INVALID_HANDLE_VALUE) {
+        async_file_close(file, 0);
+        return NULL;
+    }
+    return file;
+}
+
+/*
+ * issue
+ * ܣһ黺һsizeֽڵĶдƫΪǰλ
+ * ˵صʽں̨Уͨʽµɣ൱pread/pwrite
+ */
+static void issue(AsyncFile* file, DWORD size) {
+    int slot = file->issued % ASYNC_FILE_DEPTH;
+    OVERLAPPED* request = &file->requests[slot];
+    HANDLE event = request->hEvent;
+    memset(request, 0, sizeof(OVERLAPPED));
+    request->hEvent = event;
+    request->Offset = (DWORD)(file->position & 0xFFFFFFFFu);
+    request->OffsetHigh = (DWORD)(file->position >> 32);
+    ResetEvent(event);
+    
+    DWORD bytes = 0;
+    BOOL finished = file->writing
+        ? WriteFile(file->handle, block_of(file, slot), size, &bytes, request)
+        : ReadFile(file->handle, block_of(file, slot), size, &bytes, request);
+    file->done[slot] = finished || GetLastError() != ERROR_IO_PENDING;
+    file->done_bytes[slot] = finished ? bytes : 0;     /* ʧʱΪ0ֽ */
+    file->sizes[slot] = size;
+    file->position += size;
+    file->issued++;
+}
+
+/*
+ * wait_oldest
+ * ܣȴ;
+ * ֵʹõĻţʧܻдֽʱʧܱ
+ */
+static int wait_oldest(AsyncFile* file) {
+    int slot = file->completed % ASYNC_FILE_DEPTH;
+    DWORD bytes = file->done_bytes[slot];
+    if (!file->done[slot] &&
+        !GetOverlappedResult(file->handle, &file->requests[slot], &bytes, TRUE)) {
+        bytes = 0;
+    }
+    if (bytes != file->sizes[slot]) {
+        file->failed = 1;                       /* дʧܻļض */
+    }
+    file->completed++;
+    return slot;
+}
+
+/*
+ * issue_reads
+ * ܣплδʱ
+ */
+static void issue_reads(AsyncFile* file) {
+    while (!file->failed && file->position < file->end &&
+           file->issued - file->completed < ASYNC_FILE_DEPTH) {
+        uint64_t remaining = file->end - file->position;
+        issue(file, (DWORD)(remaining < file->block_size ? remaining : file->block_size));
+    }
+}
+
+/*
+ * async_file_open_read
+ * ܣļһ˳ȡĶ
+ * path - ļ, offset - ʼƫ, length - ֽ, block_size - ÿֽ
+ * ֵ򿪵ļʧܷNULL
+ */
+AsyncFile* async_file_open_read(const char* path, uint64_t offset, uint64_t length, size_t block_size) {
+    AsyncFile* file = open_file(path, 0, block_size);
+    if (file != NULL) {
+        file->position = offset;
+        file->end = offset + length;
+        issue_reads(file);
+    }
+    return file;
+}
+
+/*
+ * async_file_next_block
+ * ܣȴȡһݣͬʱΪ˺ݷµĶ
+ * file - ȡʽ򿪵ļ, size - ֽ
+ * ֵݣʧܷNULL
+ * ˵һηصĻʱѹ黹ٵȴ
+ */
+const unsigned char* async_file_next_block(AsyncFile* file, size_t* size) {
+    *size = 0;
+    issue_reads(file);
+    if (file->failed || file->completed == file->issued) {
+        return NULL;
+    }
+    int slot = wait_oldest(file);
+    if (file->failed) {
+        return NULL;
+    }
+    *size = file->sizes[slot];
+    return block_of(file, slot);
+}
+
+/*
+ * async_file_create
+ * ܣ½ضϣļ˳д
+ * path - ļ, block_size - ÿֽ
+ * ֵ򿪵ļʧܷNULL
+ */
+AsyncFile* async_file_create(const char* path, size_t block_size) {
+    return open_file(path, 1, block_size);
+}
+
+/*
+ * submit_block
+ * ܣѵǰ齻ϵͳдȴ
+ */
+static void submit_block(AsyncFile* file) {
+    if (file->filled > 0 && !file->failed) {
+        issue(file, (DWORD)file->filled);
+    }
+    file->filled = 0;
+}
+
+/*
+ * async_file_reserve
+ * ܣд뻺ȡýsizeֽڵλ
+ * file - д뷽ʽ򿪵ļ, size - ֽ
+ * ֵдλãдʧʱNULL
+ */
+unsigned char* async_file_reserve(AsyncFile* file, size_t size) {
+    if (size > file->block_size) {
+        file->failed = 1;                       /* ÷ */
+    }
+    if (file->filled + size > file->block_size) {
+        submit_block(file);
+    }
+    if (file->filled == 0 && file->issued - file->completed == ASYNC_FILE_DEPTH) {
+        wait_oldest(file);                      /* ȫдڳһ */
+    }
+    if (file->failed) {
+        return NULL;
+    }
+    unsigned char* position = block_of(file, file->issued % ASYNC_FILE_DEPTH) + file->filled;
+    file->filled += size;
+    return position;
+}
+
+/*
+ * async_file_failed
+ * ܣж϶дǷѾʧ
+ * file - 򿪵ļ
+ * ֵ1ʾʧܣ0ʾû
+ */
+int async_file_failed(const AsyncFile* file) {
+    return file->failed;
+}
+
+/*
+ * async_file_close
+ * ܣдʣݲȴȫرļ
+ * file - 򿪵ļ, sync - 1ʾ
+ * ֵ1ʾȫɹ0ʾʧ
+ * ˵ȡǰʱҲȴ;֮ͷ仺
+ */
+int async_file_close(AsyncFile* file, int sync) {
+    if (file == NULL) {
+        return 0;
+    }
+    if (file->writing) {
+        submit_block(file);
+    }
+    while (file->completed < file->issued) {
+        int failed = file->failed;
+        wait_oldest(file);
+        if (!file->writing) {
+            file->failed = failed;              /* δȡߵĶ󲻼 */
+        }
+    }
+    int ok = !file->failed;
+    if (file->handle != INVALID_HANDLE_VALUE) {
+        if (file->writing && sync && ok) {
+            ok = FlushFileBuffers(file->handle) != 0;   /*  */
+        }
+        ok = CloseHandle(file->handle) && ok;
+    }
+    for (int i = 0; i < ASYNC_FILE_DEPTH; i++) {
+        if (file->requests[i].hEvent != NULL) {
+            CloseHandle(file->requests[i].hEvent);
+        }
+    }
+    free(file->buffers);
+    free(file);
+    return ok;
+}
@@ -0,0 +1,74 @@
+#ifndef ASYNC_FILE_H
+#define ASYNC_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * 첽ļдģ
+ * ļ˳дУÿ鶼һζĶλдصI/O
+ * ASYNC_FILE_DEPTHͬʱ;ȡʱ漸ڶ룬ͬʱ뵱ǰ飻
+ * дʱǰ漸дͬʱһ顣
+ * 黺ڴʱһη䡢ѭʹãдвٷڴ档
+ * ϵͳ֧صI/Oʱ޷صʽļ˻ͨĶλдֻͬǲٲС
+ */
+
+#define ASYNC_FILE_DEPTH 4               /* ͬʱ;Ķд */
+
+typedef struct AsyncFile AsyncFile;      /* 򿪵ļ仺async_file.c */
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * async_file_open_read
+ * ܣļһ˳ȡĶ
+ * path - ļ, offset - ʼƫ, length - ֽ, block_size - ÿֽ
+ * ֵ򿪵ļļ޷򿪻ڴ治㷵NULL
+ */
+AsyncFile* async_file_open_read(const char* path, uint64_t offset, uint64_t length, size_t block_size);
+
+/*
+ * async_file_next_block
+ * ܣȴȡһݣͬʱΪ˺ݷµĶ
+ * file - ȡʽ򿪵ļ, size - ֽһܲblock_size
+ * ֵݣһε֮ǰЧѶȡʧܣļضϣNULL
+ */
+const unsigned char* async_file_next_block(AsyncFile* file, size_t* size);
+
+/*
+ * async_file_create
+ * ܣ½ضϣļ˳д
+ * path - ļ, block_size - ÿֽ
+ * ֵ򿪵ļļ޷ڴ治㷵NULL
+ */
+AsyncFile* async_file_create(const char* path, size_t block_size);
+
+/*
+ * async_file_reserve
+ * ܣд뻺ȡýsizeֽڵλãɵֱд
+ * file - д뷽ʽ򿪵ļ, size - ֽblock_size
+ * ֵдλãдʧʱNULL
+ * ˵ǰŲʱȰϵͳдȴҪʱȴһдڳ
+ */
+unsigned char* async_file_reserve(AsyncFile* file, size_t size);
+
+/*
+ * async_file_failed
+ * ܣж϶дǷѾʧ
+ * file - 򿪵ļ
+ * ֵ1ʾʧܣ0ʾû
+ */
+int async_file_failed(const AsyncFile* file);
+
+/*
+ * async_file_close
+ * ܣдʣݲȴȫرļͷŻ
+ * file - 򿪵ļΪNULL, sync - 1ʾдļ̺ŷ
+ * ֵ1ʾȫдɹ0ʾʧ
+ */
+int async_file_close(AsyncFile* file, int sync);
+
+#endif /* ASYNC_FILE_H */
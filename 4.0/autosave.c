@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <windows.h>
+#include "wal.h"
+#include "autosave.h"
+
+static HANDLE saver = NULL;                  /* Զ߳̾NULLʾδ */
+static HANDLE wakeup = NULL;                 /* ֪ͨ¼Զλ֪ͨϲΪһΣ */
+static volatile LONG stopping = 0;           /* 1ʾ߳̽ */
+static volatile LONG failed = 0;             /* 1ʾ̨ʧܣδ */
+static int save_interval_ms = AUTOSAVE_INTERVAL_MS;
+static int save_threshold = AUTOSAVE_DIRTY_ENTRIES;
+
+/*
+ * saver_main
+ * ܣԶ߳ڣȴ֪ͨʱֵ
+ * ˵ʱʱҲһΣ֤һĶԼ
+ */
+static DWORD WINAPI saver_main(LPVOID param) {
+    (void)param;
+    while (!stopping) {
+        WaitForSingleObject(wakeup, (DWORD)save_interval_ms);
+        if (stopping) {
+            break;
+        }
+        if (!wal_commit_group(save_threshold, save_interval_ms)) {
+            InterlockedExchange(&failed, 1);
+        }
+    }
+    return 0;
+}
+
+/*
+ * autosave_start
+ * ܣԶ߳
+ * interval_ms - ̼룩, dirty_threshold - ֵδ̸Ķ
+ * ֵ1ʾУ0ʾ޷߳
+ */
+int autosave_start(int interval_ms, int dirty_threshold) {
+    if (saver != NULL) {
+        return 1;
+    }
+    save_interval_ms = interval_ms > 0 ? interval_ms : AUTOSAVE_INTERVAL_MS;
+    save_threshold = dirty_threshold > 0 ? dirty_threshold : AUTOSAVE_DIRTY_ENTRIES;
+    stopping = 0;
+    wakeup = CreateEventA(NULL, FALSE, FALSE, NULL);
+    if (wakeup == NULL) {
+        return 0;
+    }
+    saver = CreateThread(NULL, 0, saver_main, NULL, 0, NULL);
+    if (saver == NULL) {
+        CloseHandle(wakeup);
+        wakeup = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * autosave_notify
+ * ܣ֪ͨԶ߳µĸĶ
+ * 
+ */
+void autosave_notify(void) {
+    if (saver != NULL) {
+        SetEvent(wakeup);                    /* ¼λʱٴλۼ */
+    }
+}
+
+/*
+ * autosave_failed
+ * ܣжϴβѯ̨Ƿʧ
+ * 
+ * ֵ1ʾʧܣ0ʾûʧ
+ */
+int autosave_failed(void) {
+    return InterlockedExchange(&failed, 0) != 0;
+}
+
+/*
+ * autosave_stop
+ * ܣֹͣԶ߳
+ * 
+ */
+void autosave_stop(void) {
+    if (saver == NULL) {
+        return;
+    }
+    stopping = 1;
+    SetEvent(wakeup);
+    WaitForSingleObject(saver, INFINITE);
+    CloseHandle(saver);
+    CloseHandle(wakeup);
+    saver = NULL;
+    wakeup = NULL;
+}
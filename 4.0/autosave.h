@@ -0,0 +1,56 @@
+#ifndef AUTOSAVE_H
+#define AUTOSAVE_H
+
+#include "wal.h"
+
+/*
+ * Զģ
+ * ÿθĶ׷ӵԤд־wal.hʱǰ־̡ͬ
+ * ģں̨߳ɴͬ˵ֻ֪֮ͨһȴ̣
+ *   δ̵ĸĶﵽdirty_thresholdһѵȴinterval_msʱһΣ
+ *   ͬڼĶ֪ͨϲΪһΣͬڼĸĶһΡ
+ * ļдɺ̨ɣcheckpoint.h
+ */
+
+#define AUTOSAVE_INTERVAL_MS WAL_GROUP_COMMIT_MS           /* Ĭ̼룩 */
+#define AUTOSAVE_DIRTY_ENTRIES WAL_GROUP_COMMIT_ENTRIES    /* Ĭֵδ̸Ķ */
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * autosave_start
+ * ܣԶ߳
+ * interval_ms - һĶȴú,
+ *       dirty_threshold - δ̸Ķﵽ
+ * ֵ1ʾУ0ʾ޷̣߳ʱԿwal_commiṭ
+ */
+int autosave_start(int interval_ms, int dirty_threshold);
+
+/*
+ * autosave_notify
+ * ܣ֪ͨԶ߳µĸĶ
+ * 
+ * ˵ÿβ˵֮ãδĶ֪ͨϲΪһΣ߳δʱκ
+ */
+void autosave_notify(void);
+
+/*
+ * autosave_failed
+ * ܣжϴβѯ̨Ƿʧ
+ * 
+ * ֵ1ʾʧܣĶļܳ־û0ʾûʧ
+ */
+int autosave_failed(void);
+
+/*
+ * autosave_stop
+ * ܣֹͣԶ̣߳ȴڽеͬ
+ * 
+ * ˵˳ǰãδ̵ĸĶɵwal_commit洦
+ */
+void autosave_stop(void);
+
+#endif /* AUTOSAVE_H */
@@ -0,0 +1,196 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <io.h>
+#include <windows.h>
+#include "data_struct.h"
+#include "player_store.h"
+#include "file_ops.h"
+#include "wal.h"
+#include "dirty_tracker.h"
+#include "checkpoint.h"
+
+/*
+ * һμҪдݣpatchǿʱ͵ظддrecords
+ * ̨ʱrecordsΪpatchteam_tableҲ̨߳
+ */
+typedef struct CheckpointJob {
+    char data_file[260];            /* ļ */
+    char rotated_file[260];         /* ־ļ */
+    DirtyPatch* patch;              /* ͵ظдݣNULLʾд */
+    Player* records;                /* ¼ */
+    int count;                      /* ¼ */
+    unsigned char* team_table;      /* Ʊ */
+    int team_count;                 /* Ʊ */
+    int owns_records;               /* 1ʾrecordsΪͷ */
+    int result;                     /* 1ʾɹ0ʾʧ */
+} CheckpointJob;
+
+static CheckpointJob job;                    /* ǰһΣ */
+static HANDLE worker = NULL;                 /* ̨߳̾NULLʾûڽ */
+static DWORD last_checkpoint_tick = 0;       /* ϴμ㿪ʼʱ */
+static int timer_started = 0;                /* Ƿѿʼʱ */
+
+/*
+ * file_exists
+ * ܣжļǷ
+ */
+static int file_exists(const char* path) {
+    return GetFileAttributesA(path) != INVALID_FILE_ATTRIBUTES;
+}
+
+/*
+ * sync_file
+ * ܣļ̣ļʱκ£
+ * ˵־ʱȴ̣wal_rotate־ں̨߳о̣
+ *       ˺ļд֮ǰϵҲᶪʧеĸĶ
+ */
+static void sync_file(const char* path) {
+    FILE* file = fopen(path, "r+b");
+    if (file != NULL) {
+        _commit(_fileno(file));
+        fclose(file);
+    }
+}
+
+/*
+ * run_job
+ * ܣ͵ظдļдļдʱļ滻ɹɾ־
+ * ˵дļɾ־ж֮ʱ־طļ֮Ͻ䣻
+ *       ᶪʧ־еĸĶ
+ */
+static void run_job(CheckpointJob* current) {
+    sync_file(current->rotated_file);           /* ʧҲ޷ļдɺ־Ҫ */
+    if (current->patch != NULL) {
+        current->result = dirty_patch_apply(current->patch);   /* ͬʱͷŸд */
+        current->patch = NULL;
+    } else {
+        current->result = write_player_snapshot(current->data_file, current->records, current->count,
+                                                current->team_table, current->team_count);
+    }
+    current->result = current->result &&
+                      (DeleteFileA(current->rotated_file) || !file_exists(current->rotated_file));
+    if (current->owns_records) {
+        free(current->records);
+    }
+    free(current->team_table);
+    current->records = NULL;
+    current->team_table = NULL;
+}
+
+/*
+ * worker_main
+ * ܣ̨߳
+ */
+static DWORD WINAPI worker_main(LPVOID param) {
+    run_job((CheckpointJob*)param);
+    return 0;
+}
+
+/*
+ * checkpoint_due
+ * ܣжǷӦм
+ * rotated_path - ־ļ
+ * ֵ1ʾӦУ0ʾ
+ */
+int checkpoint_due(const char* rotated_path) {
+    if (!timer_started) {
+        last_checkpoint_tick = GetTickCount();
+        timer_started = 1;
+    }
+    if (worker != NULL) {
+        return 0;                            /* һλڽ */
+    }
+    if (file_exists(rotated_path)) {
+        return 1;                            /* ־첢 */
+    }
+    int entries = wal_entry_count();
+    return entries >= CHECKPOINT_LOG_ENTRIES ||
+           (entries > 0 && GetTickCount() - last_checkpoint_tick >= CHECKPOINT_INTERVAL_MS);
+}
+
+/*
+ * checkpoint_start
+ * ܣһμ
+ * data_file - ļ, rotated_path - ־ļ,
+ *       background - 1ʾں̨߳дļ0ʾд
+ * ֵ1ʾں̨ʼѵɣ0ʾʧ
+ * ˼·ĶԾ͵дʱֻȡĶļ¼dirty_tracker.h
+ *           д룬̨ʱȫ¼ÿ64ֽڣԼʮڴ濽
+ *           ȡ򿽱֮߳̿޸Ĵ洢Ӱд
+ */
+int checkpoint_start(const char* data_file, const char* rotated_path, int background) {
+    checkpoint_finish(1);                    /* ͬʱֻһ */
+    last_checkpoint_tick = GetTickCount();
+    timer_started = 1;
+    int rotate = background && !file_exists(rotated_path);   /* ־ʱд */
+    
+    /* һȡĶܾ͵ظдʱֻдĶĲλ */
+    memset(&job, 0, sizeof(job));
+    strncpy(job.data_file, data_file, sizeof(job.data_file) - 1);
+    strncpy(job.rotated_file, rotated_path, sizeof(job.rotated_file) - 1);
+    job.patch = dirty_tracker_take_patch(data_file);
+    
+    /* ڶܾ͵ظдʱ׼д룬̨ʱ¼ */
+    if (job.patch == NULL) {
+        job.team_table = pack_team_table(&job.team_count);
+        if (job.team_table == NULL) {
+            dirty_tracker_reset();
+            return 0;                        /* ڴ治 */
+        }
+        job.count = player_store.count;
+        job.records = player_store.records;
+        if (rotate) {
+            size_t size = (size_t)job.count * sizeof(Player);
+            Player* copy = (Player*)malloc(size > 0 ? size : 1);
+            if (copy != NULL) {
+                memcpy(copy, player_store.records, size);
+                job.records = copy;
+                job.owns_records = 1;
+            } else {
+                rotate = 0;                  /* ڴ治㣺Ϊд */
+            }
+        }
+        dirty_tracker_begin_all(data_file);  /* дļλ洢λ */
+    }
+    
+    /* л־󽻸̨̣߳˵ճӦ */
+    if (rotate && wal_rotate(rotated_path)) {
+        worker = CreateThread(NULL, 0, worker_main, &job, 0, NULL);
+        if (worker != NULL) {
+            return 1;
+        }
+        run_job(&job);                       /* ޷̣߳д */
+        if (!job.result) dirty_tracker_reset();
+        return job.result;
+    }
+    
+    /* Ĳд꣬ļѰȫĶյǰ־ */
+    run_job(&job);
+    if (!job.result) {
+        dirty_tracker_reset();               /* ļ״̬´д */
+        return 0;
+    }
+    return wal_reset();
+}
+
+/*
+ * checkpoint_finish
+ * ܣѽĺ̨߳
+ * wait - 1ʾһֱȵ0ʾδʱ
+ * ֵ1ʾмɹ0ʾмʧܣ-1ʾûмڽлδ
+ */
+int checkpoint_finish(int wait) {
+    if (worker == NULL) {
+        return -1;
+    }
+    if (WaitForSingleObject(worker, wait ? INFINITE : 0) != WAIT_OBJECT_0) {
+        return -1;                           /* д */
+    }
+    CloseHandle(worker);
+    worker = NULL;
+    if (!job.result) {
+        dirty_tracker_reset();               /* ļ״̬´д */
+    }
+    return job.result;
+}
@@ -0,0 +1,56 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+/*
+ * ̨ģ
+ * Ԥд־wal.hĶļա
+ * дһļʱ¼ȣ˷ŵ̨߳нУ˵ճӦ
+ *   1. ߳ȡϴдĶļ¼dirty_tracker.hĶ޷͵дʱ
+ *      ȫ¼Ʊ־Ϊ"־"¸Ķд־
+ *   2. ̨߳̾͵ظдļиĶĲλѿдʱļ滻ļ
+ *      ɾ־
+ * һжʱļ + ־ + ־ طԵõݣطſظ
+ * ˼ʱطž־طŵǰ־
+ * ־ﵽCHECKPOINT_LOG_ENTRIESϴμ㳬CHECKPOINT_INTERVAL_MS
+ * ־ǿʱӦм㣻߳ÿβ˵֮һΡ
+ */
+
+#define CHECKPOINT_LOG_ENTRIES 1024      /* ־ﵽм */
+#define CHECKPOINT_INTERVAL_MS 300000    /* ϴμ㳬ú־ǿռм */
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * checkpoint_due
+ * ܣжǷӦм
+ * rotated_path - ־ļ
+ * ֵ1ʾӦУ־㹻㹻û־0ʾ
+ * ˵̨ʱ0״εʱʼʱ
+ */
+int checkpoint_due(const char* rotated_path);
+
+/*
+ * checkpoint_start
+ * ܣһμ
+ * data_file - ļ, rotated_path - ־ļ,
+ *       background - 1ʾں̨߳дļ0ʾд
+ * ֵ1ʾں̨ʼѵɣ0ʾʧܣ־ֲ䣩
+ * ˵һκ̨δʱȵȴ־ϴμʧܻжϣ
+ *       ־м¼дʧܻڴ治ʱΪд
+ */
+int checkpoint_start(const char* data_file, const char* rotated_path, int background);
+
+/*
+ * checkpoint_finish
+ * ܣѽĺ̨߳
+ * wait - 1ʾһֱȵ0ʾδʱ
+ * ֵ1ʾмɹ0ʾмʧܣ־´ε
+ *         -1ʾûмڽлδ
+ * ˵¼ءļ˳֮ǰwait=1
+ */
+int checkpoint_finish(int wait);
+
+#endif /* CHECKPOINT_H */
@@ -0,0 +1,28 @@
+#ifndef CRC32C_H
+#define CRC32C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * CRC32CУģ飨Castagnoliʽ0x1EDC6F41
+ * ڷļбضϡдλתļ¼
+ * ֧SSE4.2ĴʹӲCRC32ָÿָ8ֽڣ32λ4ֽڣ
+ * УٶȽӽڴֽڲ㣬ͬ
+ */
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * crc32c
+ * ܣһݵCRC32Cֵ
+ * data - ׵ַ, size - ֽ
+ * ֵ32λCRC32Cֵֵȡͨжһ£"123456789"ĽΪ0xE3069283
+ * ˵ڶ߳ͬʱ
+ */
+uint32_t crc32c(const void* data, size_t size);
+
+#endif /* CRC32C_H */
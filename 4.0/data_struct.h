@@ -1,29 +1,44 @@
 #ifndef DATA_STRUCT_H
 #define DATA_STRUCT_H
 
+#include <stdint.h>
+
+/*
+ * λö٣5׼λãڴ1ֽڱ뱣
+ */
+typedef enum PlayerPosition {
+    POSITION_PG = 0,        /*  */
+    POSITION_SG = 1,        /* ÷ֺ */
+    POSITION_SF = 2,        /* Сǰ */
+    POSITION_PF = 3,        /* ǰ */
+    POSITION_C = 4,         /* з */
+    POSITION_COUNT = 5,     /* λ */
+    POSITION_INVALID = 255  /* Ƿλ */
+} PlayerPosition;
+
 /*
  * ԱϢṹ嶨
- * id: ѧ(12λַ) +  = 13ֽ
+ * id_key: ѧŴɵ64λҡļдһʹøüȽ
+ * id: ѧ(12λַ) +  = 13ֽڣʾ
  * name: (10ֻ20Ӣַ) +  = 21ֽ
- * team: (15ֻ30Ӣַ) +  = 31ֽ
- * position: λ(5: PG/SG/SF/PF/C) +  = 11ֽ
+ * team_id: ӱţ(15ֻ30Ӣַ)פ(team_pool.h)
+ * position: λñ(PlayerPositionö)ıʽֻʾʱת
  * height: (cm)Χ100-250
  * weight: (kg)Χ40-200
  * jersey: º룬Χ0-99
- * next: ָ룬ڹԱ
+ * ¼ָ룬ͳһplayer_storeУplayer_store.h
  */
 typedef struct Player {
+    uint64_t id_key;        /* ѧidֶδõ */
     char id[13];            /* ѧֶΣ̶12λ */
     char name[21];          /* ֶΣ洢Աȫ */
-    char team[31];          /* ֶΣ¼ѧԺ */
-    char position[11];      /* λֶΣ¼Աλ */
+    uint16_t team_id;       /* ֶΣפеӱ */
+    uint8_t position;       /* λֶΣPlayerPositionöֵ */
     int height;             /* ֶΣλ */
     int weight;             /* ֶΣλǧ */
     int jersey;             /* ֶΣԱ */
-    struct Player* next;    /* ֶָΣָһԱڵ */
 } Player;
 
-/* ȫֱ */
-extern Player* player_list;
+#define INVALID_PLAYER_KEY UINT64_MAX   /* ǷѧŶӦ */
 
 #endif /* DATA_STRUCT_H */
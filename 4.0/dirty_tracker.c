@@ -0,0 +1,391 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <io.h>
+#include "data_struct.h"
+#include "player_store.h"
+#include "team_pool.h"
+#include "file_format.h"
+#include "id_file_index.h"
+#include "dirty_tracker.h"
+
+/*
+ * һд¼ļλ
+ */
+typedef struct PatchRecord {
+    int slot;                                   /* ļеĲλ± */
+    unsigned char bytes[PLAYER_FILE_RECORD_SIZE];   /* ¼ղ۵Ĵʽ */
+} PatchRecord;
+
+/*
+ * һξ͵ظдȫݣȡô洢ɽ̨߳
+ */
+struct DirtyPatch {
+    char filename[260];                         /* ļ */
+    int old_slots, new_slots;                   /* дǰ¼λ */
+    int old_teams, new_teams;                   /* дǰ */
+    int old_tombstones, new_tombstones;         /* дǰղ */
+    PatchRecord* records;                       /* д¼׷ӵĲλ˳ں */
+    int record_count;                           /* д¼ */
+    unsigned char* team_entries;                /* ӵƱ */
+};
+
+static int tracking = 0;                        /* 1ʾļ洢һһӦɾ͵ظд */
+static char tracked_file[260];                  /* ٵļ */
+static int* handle_slot = NULL;                 /*  -> ļλ-1ʾδдļ */
+static unsigned char* handle_dirty = NULL;      /* ǷڸĶб */
+static int handle_capacity = 0;                 /*  */
+static PlayerHandle* dirty_list = NULL;         /* ĶľÿһΣ */
+static int dirty_count = 0, dirty_capacity = 0;
+static int* tombstone_list = NULL;              /* дΪղ۵ļλ */
+static int tombstone_count = 0, tombstone_capacity = 0;
+static int file_slots = 0;                      /* ļ¼λղۣ */
+static int file_tombstones = 0;                 /* ļеĿղ */
+static int file_team_count = 0;                 /* ļе */
+static int file_team_capacity = 0;              /* ļƱԤλ */
+
+/*
+ * push_value
+ * ܣĩβ׷һֵ0ʾڴ治
+ */
+static int push_value(int** list, int* count, int* capacity, int value) {
+    if (*count == *capacity) {
+        int new_capacity = *capacity > 0 ? *capacity * 2 : 256;
+        int* grown = (int*)realloc(*list, (size_t)new_capacity * sizeof(int));
+        if (grown == NULL) return 0;
+        *list = grown;
+        *capacity = new_capacity;
+    }
+    (*list)[(*count)++] = value;
+    return 1;
+}
+
+/*
+ * grow_handles
+ * ܣ֤±handleֱΪδд롢δĶ
+ */
+static int grow_handles(PlayerHandle handle) {
+    if (handle < handle_capacity) return 1;
+    int new_capacity = handle_capacity > 0 ? handle_capacity : 1024;
+    while (new_capacity <= handle) new_capacity *= 2;
+    int* slots = (int*)realloc(handle_slot, (size_t)new_capacity * sizeof(int));
+    if (slots == NULL) return 0;
+    handle_slot = slots;
+    unsigned char* dirty = (unsigned char*)realloc(handle_dirty, (size_t)new_capacity);
+    if (dirty == NULL) return 0;
+    handle_dirty = dirty;
+    for (int h = handle_capacity; h < new_capacity; h++) {
+        handle_slot[h] = -1;
+        handle_dirty[h] = 0;
+    }
+    handle_capacity = new_capacity;
+    return 1;
+}
+
+/*
+ * dirty_tracker_reset
+ * ܣֹͣ٣ļ˺д
+ * 
+ */
+void dirty_tracker_reset(void) {
+    tracking = 0;
+    for (int h = 0; h < handle_capacity; h++) {
+        handle_slot[h] = -1;
+        handle_dirty[h] = 0;
+    }
+    dirty_count = 0;
+    tombstone_count = 0;
+}
+
+/*
+ * dirty_tracker_begin
+ * ܣʼһļδǼκμ¼
+ * filename - ļ, header - ļļͷ
+ */
+void dirty_tracker_begin(const char* filename, const PlayerFileHeader* header) {
+    dirty_tracker_reset();
+    tracking = 1;
+    strncpy(tracked_file, filename, sizeof(tracked_file) - 1);
+    tracked_file[sizeof(tracked_file) - 1] = '\0';
+    file_slots = (int)header->record_count;
+    file_tombstones = (int)header->tombstone_count;
+    file_team_count = (int)header->team_count;
+    file_team_capacity = file_format_team_capacity(header);
+}
+
+/*
+ * dirty_tracker_begin_all
+ * ܣ洢ǰݿʼ٣i洢λӦļiλ
+ * filename - ļ
+ * ˵ļwrite_player_snapshotдһ
+ */
+void dirty_tracker_begin_all(const char* filename) {
+    PlayerFileHeader header;
+    file_format_init_header(&header, player_store.count, team_pool_count());
+    dirty_tracker_begin(filename, &header);
+    for (int slot = 0; slot < player_store.count; slot++) {
+        dirty_tracker_bind(player_store_handle_at(slot), slot);
+    }
+}
+
+/*
+ * dirty_tracker_bind
+ * ܣǼһ¼ļеĲλ
+ * handle - Ա, file_slot - ļеĲλ±
+ */
+void dirty_tracker_bind(PlayerHandle handle, int file_slot) {
+    if (!tracking) return;
+    if (!grow_handles(handle)) {
+        dirty_tracker_reset();                  /* ڴ治㣺٣´д */
+        return;
+    }
+    handle_slot[handle] = file_slot;
+}
+
+/*
+ * dirty_tracker_mark
+ * ܣǼһ¼Ķ
+ * handle - Ա
+ */
+void dirty_tracker_mark(PlayerHandle handle) {
+    if (!tracking || handle < 0) return;
+    if (!grow_handles(handle)) {
+        dirty_tracker_reset();
+        return;
+    }
+    if (handle_dirty[handle]) return;           /* б */
+    if (!push_value(&dirty_list, &dirty_count, &dirty_capacity, handle)) {
+        dirty_tracker_reset();
+        return;
+    }
+    handle_dirty[handle] = 1;
+}
+
+/*
+ * dirty_tracker_remove
+ * ܣǼһ¼ɾļλдΪղ
+ * handle - Ա
+ * ˵ڸĶбУȡʱ־ѿмʱΪ¼¼׷
+ */
+void dirty_tracker_remove(PlayerHandle handle) {
+    if (!tracking || handle < 0 || handle >= handle_capacity) return;
+    if (handle_slot[handle] >= 0 &&
+        !push_value(&tombstone_list, &tombstone_count, &tombstone_capacity, handle_slot[handle])) {
+        dirty_tracker_reset();
+        return;
+    }
+    handle_slot[handle] = -1;
+}
+
+/*
+ * free_patch
+ * ܣͷŸд
+ */
+static void free_patch(DirtyPatch* patch) {
+    free(patch->records);
+    free(patch->team_entries);
+    free(patch);
+}
+
+/*
+ * dirty_tracker_take_patch
+ * ܣȡϴдȫĶΪһξ͵ظд
+ * filename - Ҫдļ
+ * ֵдݣܾ͵ظдʱNULLд
+ * ˼·ͳ׷ӵļ¼ղ۹ƱŲʱдѹ
+ *           룬Ϊ¼¼ĩβĲλ
+ */
+DirtyPatch* dirty_tracker_take_patch(const char* filename) {
+    int team_count = team_pool_count();
+    if (!tracking || strcmp(filename, tracked_file) != 0 || team_count > file_team_capacity) {
+        return NULL;                            /* δٸļƱûпλ */
+    }
+    
+    /* һжϿղ۱ */
+    int appended = 0;                           /* ׷ӵļ¼ */
+    for (int i = 0; i < dirty_count; i++) {
+        PlayerHandle handle = dirty_list[i];
+        if (player_store_get(handle) != NULL && handle_slot[handle] < 0) appended++;
+    }
+    long long tombstones = (long long)file_tombstones + tombstone_count;
+    if (tombstones * 100 > (long long)(file_slots + appended) * COMPACT_TOMBSTONE_PERCENT) {
+        return NULL;                            /* ղ۹࣬дѹ */
+    }
+    
+    /* ڶд */
+    DirtyPatch* patch = (DirtyPatch*)calloc(1, sizeof(DirtyPatch));
+    int capacity = dirty_count + tombstone_count;
+    if (patch != NULL) {
+        patch->records = (PatchRecord*)malloc((size_t)(capacity > 0 ? capacity : 1) * sizeof(PatchRecord));
+        patch->team_entries = (unsigned char*)calloc((size_t)(team_count - file_team_count + 1),
+                                                     PLAYER_FILE_TEAM_ENTRY_SIZE);
+    }
+    if (patch == NULL || patch->records == NULL || patch->team_entries == NULL) {
+        if (patch != NULL) free_patch(patch);
+        return NULL;                            /* ڴ治㣬Ϊд */
+    }
+    memcpy(patch->filename, tracked_file, sizeof(patch->filename));
+    patch->old_slots = file_slots;
+    patch->old_teams = file_team_count;
+    patch->old_tombstones = file_tombstones;
+    
+    /* ղۡĶļ¼¼¼ */
+    for (int i = 0; i < tombstone_count; i++) {
+        PatchRecord* record = &patch->records[patch->record_count++];
+        record->slot = tombstone_list[i];
+        file_format_encode_tombstone(record->bytes);
+    }
+    for (int i = 0; i < dirty_count; i++) {
+        PlayerHandle handle = dirty_list[i];
+        handle_dirty[handle] = 0;
+        const Player* player = player_store_get(handle);
+        if (player == NULL) continue;           /* ѱɾ */
+        if (handle_slot[handle] < 0) {
+            handle_slot[handle] = file_slots++; /* ¼¼׷ĩβ */
+        }
+        PatchRecord* record = &patch->records[patch->record_count++];
+        record->slot = handle_slot[handle];
+        file_format_encode_record(player, record->bytes);   /* ӱżƱ± */
+    }
+    for (int t = file_team_count; t < team_count; t++) {
+        strncpy((char*)patch->team_entries + (size_t)(t - file_team_count) * PLAYER_FILE_TEAM_ENTRY_SIZE,
+                team_pool_name(t), PLAYER_FILE_TEAM_ENTRY_SIZE - 1);
+    }
+    
+    /* ĲΪд */
+    file_tombstones += tombstone_count;
+    file_team_count = team_count;
+    patch->new_slots = file_slots;
+    patch->new_teams = file_team_count;
+    patch->new_tombstones = file_tombstones;
+    dirty_count = 0;
+    tombstone_count = 0;
+    return patch;
+}
+
+/*
+ * seek_to / read_at / write_at / sync_file
+ * ܣλָƫƣָƫƶдһݣļˢµ
+ * ˵ƫƿɳ2GB64λ_fseeki64longֻ32λ
+ *       λʧʱдѼ¼дļдλ
+ */
+static int seek_to(FILE* file_ptr, uint64_t offset) {
+    return offset <= (uint64_t)INT64_MAX && _fseeki64(file_ptr, (__int64)offset, SEEK_SET) == 0;
+}
+
+static int read_at(FILE* file_ptr, uint64_t offset, void* data, size_t size) {
+    return seek_to(file_ptr, offset) && fread(data, size, 1, file_ptr) == 1;
+}
+
+static int write_at(FILE* file_ptr, uint64_t offset, const void* data, size_t size) {
+    return seek_to(file_ptr, offset) && fwrite(data, size, 1, file_ptr) == 1;
+}
+
+static int sync_file(FILE* file_ptr) {
+    return fflush(file_ptr) == 0 && _commit(_fileno(file_ptr)) == 0;
+}
+
+/*
+ * update_id_file_index
+ * ܣѸдĲλͬѧļid_file_index.h
+ * ˵ڻʧʱӰļں˻ڴ
+ */
+static void update_id_file_index(const DirtyPatch* patch, const PlayerFileFooter* old_footer,
+                                  const PlayerFileFooter* new_footer) {
+    IdFileIndexChange* changes = (IdFileIndexChange*)malloc(
+        (size_t)(patch->record_count > 0 ? patch->record_count : 1) * sizeof(IdFileIndexChange));
+    if (changes == NULL) {
+        return;
+    }
+    Player player;
+    for (int i = 0; i < patch->record_count; i++) {
+        file_format_decode_record(patch->records[i].bytes, &player);
+        changes[i].slot = patch->records[i].slot;
+        changes[i].key = player.team_id == PLAYER_FILE_TOMBSTONE_TEAM ? INVALID_PLAYER_KEY : player.id_key;
+    }
+    id_file_index_patch(patch->filename, old_footer, new_footer, changes, patch->record_count);
+    free(changes);
+}
+
+/*
+ * dirty_patch_apply
+ * ܣѸддļͷŸд
+ * patch - dirty_tracker_take_patchĽ
+ * ֵ1ʾɹ0ʾʧ
+ * ˼·ļͷ ->  -> дλ׷Ӽ¼ӡдļβ -> 
+ *           -> дļͷ -> ̣УͰдĲλ
+ */
+int dirty_patch_apply(DirtyPatch* patch) {
+    if (patch->record_count == 0 && patch->new_teams == patch->old_teams) {
+        free_patch(patch);
+        return 1;                               /* ûиĶ */
+    }
+    FILE* file_ptr = fopen(patch->filename, "r+b");
+    unsigned char header_bytes[PLAYER_FILE_HEADER_SIZE];
+    unsigned char bytes[PLAYER_FILE_RECORD_SIZE];    /* λݣļβ */
+    PlayerFileHeader header;
+    PlayerFileFooter footer;
+    memset(&header, 0, sizeof(header));
+    memset(&footer, 0, sizeof(footer));
+    
+    /* һ˶ļϴдӣȡԭУ */
+    int ok = file_ptr != NULL && read_at(file_ptr, 0, header_bytes, sizeof(header_bytes)) &&
+             file_format_decode_header(header_bytes, &header) &&
+             header.version == PLAYER_FILE_VERSION && header.flags == 0 &&
+             (int)header.record_count == patch->old_slots && (int)header.team_count == patch->old_teams &&
+             (int)header.tombstone_count == patch->old_tombstones &&
+             read_at(file_ptr, file_format_record_offset(&header, patch->old_slots),
+                     bytes, PLAYER_FILE_FOOTER_SIZE) &&
+             file_format_decode_footer(bytes, &footer) && (int)footer.record_count == patch->old_slots;
+    uint32_t checksum = footer.checksum;
+    PlayerFileFooter old_footer = footer;      /* ں˶ѧļ */
+    
+    /* ڶڸд */
+    header.flags |= PLAYER_FILE_FLAG_PATCHING;
+    file_format_encode_header(&header, header_bytes);
+    ok = ok && write_at(file_ptr, 0, header_bytes, sizeof(header_bytes)) && sync_file(file_ptr);
+    
+    /* дλ׷Ӽ¼Уͼɼ */
+    for (int i = 0; ok && i < patch->record_count; i++) {
+        const PatchRecord* record = &patch->records[i];
+        uint64_t offset = file_format_record_offset(&header, record->slot);
+        if (record->slot < patch->old_slots) {
+            ok = read_at(file_ptr, offset, bytes, sizeof(bytes));
+            checksum -= file_format_record_checksum(&header, bytes);
+        }
+        ok = ok && write_at(file_ptr, offset, record->bytes, sizeof(record->bytes));
+        checksum += file_format_record_checksum(&header, record->bytes);
+    }
+    
+    /* ĲдƱԤλ */
+    for (int t = patch->old_teams; ok && t < patch->new_teams; t++) {
+        const unsigned char* entry = patch->team_entries + (size_t)(t - patch->old_teams) * PLAYER_FILE_TEAM_ENTRY_SIZE;
+        ok = write_at(file_ptr, header.team_table_offset + (uint64_t)t * PLAYER_FILE_TEAM_ENTRY_SIZE,
+                      entry, PLAYER_FILE_TEAM_ENTRY_SIZE);
+        checksum += file_format_team_checksum(&header, entry);
+    }
+    
+    /* 岽ļβƵ¼µĩβ */
+    footer.record_count = (uint32_t)patch->new_slots;
+    footer.checksum = checksum;
+    file_format_encode_footer(&footer, bytes);
+    ok = ok && write_at(file_ptr, file_format_record_offset(&header, patch->new_slots),
+                        bytes, PLAYER_FILE_FOOTER_SIZE) && sync_file(file_ptr);
+    
+    /* дļͷ */
+    header.record_count = (uint32_t)patch->new_slots;
+    header.team_count = (uint32_t)patch->new_teams;
+    header.tombstone_count = (uint32_t)patch->new_tombstones;
+    header.flags &= ~PLAYER_FILE_FLAG_PATCHING;
+    file_format_encode_header(&header, header_bytes);
+    ok = ok && write_at(file_ptr, 0, header_bytes, sizeof(header_bytes)) && sync_file(file_ptr);
+    
+    if (file_ptr != NULL) {
+        ok = (fclose(file_ptr) == 0) && ok;
+    }
+    if (ok) {
+        update_id_file_index(patch, &old_footer, &footer);
+    }
+    free_patch(patch);
+    return ok;
+}
@@ -0,0 +1,94 @@
+#ifndef DIRTY_TRACKER_H
+#define DIRTY_TRACKER_H
+
+#include "data_struct.h"
+#include "player_store.h"
+#include "file_format.h"
+
+/*
+ * Ķ¼ģ
+ * ļеļ¼Ķһ¼ֻдڵĲλģסÿ¼
+ * ļеĲλԼϴдĶɾЩ¼
+ * 㣨checkpoint.hݴֻдЩλдļ
+ *   Ķļ¼ԭλ͵ظд
+ *   ļ¼׷ڼ¼ĩβ
+ *   ɾļ¼ԭλдΪղۣղ۹ʱΪдѹ
+ *   ӣдƱԤλλʱΪд
+ * УΪУֵ֮ͣдʱȥɲλУֵټµļɣضȡļ
+ * дǰļͷǣȫд;жϵļʱ˶Уͣ
+ * ȱʧĸĶ־طŲ루־ڸдɺɾ
+ */
+
+#define COMPACT_TOMBSTONE_PERCENT 25     /* ղ۳¼ðٷֱʱΪд */
+
+typedef struct DirtyPatch DirtyPatch;    /* һξ͵ظдȫݣdirty_tracker.c */
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * dirty_tracker_reset
+ * ܣֹͣ٣ļ˺д
+ * 
+ * ˵ؾɸʽļӳģʽдʧʱ
+ */
+void dirty_tracker_reset(void);
+
+/*
+ * dirty_tracker_begin
+ * ܣʼһļδǼκμ¼
+ * filename - ļ, header - ļļͷ
+ * ˵ʱãdirty_tracker_bindǼ
+ */
+void dirty_tracker_begin(const char* filename, const PlayerFileHeader* header);
+
+/*
+ * dirty_tracker_begin_all
+ * ܣ洢ǰݿʼ٣i洢λӦļiλ
+ * filename - ļ
+ * ˵дļʱãдΪʱĴ洢ݣдʧdirty_tracker_reset
+ */
+void dirty_tracker_begin_all(const char* filename);
+
+/*
+ * dirty_tracker_bind
+ * ܣǼһ¼ļеĲλ
+ * handle - Ա, file_slot - ļеĲλ±
+ */
+void dirty_tracker_bind(PlayerHandle handle, int file_slot);
+
+/*
+ * dirty_tracker_mark
+ * ܣǼһ¼Ķ
+ * handle - Ա
+ */
+void dirty_tracker_mark(PlayerHandle handle);
+
+/*
+ * dirty_tracker_remove
+ * ܣǼһ¼ɾļλдΪղ
+ * handle - Աplayer_store_remove֮ǰã
+ */
+void dirty_tracker_remove(PlayerHandle handle);
+
+/*
+ * dirty_tracker_take_patch
+ * ܣȡϴдȫĶΪһξ͵ظд
+ * filename - Ҫдļ
+ * ֵдݣdirty_patch_applyܾ͵ظдʱNULLд
+ * ˵̵߳ãȡΪд룬дʧdirty_tracker_reset
+ */
+DirtyPatch* dirty_tracker_take_patch(const char* filename);
+
+/*
+ * dirty_patch_apply
+ * ܣѸддļͷŸд
+ * patch - dirty_tracker_take_patchĽ
+ * ֵ1ʾɹ0ʾʧܣļܴŸдǣд
+ * ˵ֻpatchں̵̨߳
+ */
+int dirty_patch_apply(DirtyPatch* patch);
+
+#endif /* DIRTY_TRACKER_H */
@@ -3,7 +3,13 @@
 #include <string.h>
 #include <windows.h>
 #include "data_struct.h"
+#include "player_store.h"
+#include "team_pool.h"
+#include "file_ops.h"
+#include "player_manager.h"
 #include "stats_calculator.h"
+#include "efficiency_batch.h"
+#include "leaderboard.h"
 #include "display_manager.h"
 
 /*
@@ -21,7 +27,7 @@ void set_console_color(int color_code) {
  * display_player_card
  * ܣԿƬʽʾԱϸϢ
  * player - ҪʾԱṹָ
- * ƣģԱϢƬ߿ɫ
+ * ƣģԱϢƬ߿ɫ룻ٷλ
  */
 void display_player_card(const Player* player) {
     if (player == NULL) {
@@ -40,13 +46,28 @@ void display_player_card(const Player* player) {
     // ֱʹðŶ룬߿
     printf("ѧ   : %s\n", player->id);
     printf("   : %s\n", player->name);
-    printf("   : %s\n", player->team);
-    printf("λ   : %s\n", player->position);
+    printf("   : %s\n", team_pool_name(player->team_id));
+    printf("λ   : %s\n", position_name(player->position));
     printf("   : %d cm\n", player->height);
     printf("   : %d kg\n", player->weight);
     printf("   : #%d\n", player->jersey);
     printf("Чֵ : %.1f \n", efficiency);
     
+    /* ٷλȡЧа񣬲ɨȫԱ¼ڴ洢ʱʾ */
+    PlayerHandle handle = player_store_handle_of(player);
+    if (handle != INVALID_PLAYER_HANDLE && ensure_player_indexes(INDEX_LEADERBOARD)) {
+        double percentile = 0.0;
+        int league_rank = leaderboard_rank(LEADERBOARD_LEAGUE, 0, handle, &percentile);
+        int team_rank = leaderboard_rank(LEADERBOARD_TEAM, player->team_id, handle, NULL);
+        if (league_rank > 0) {
+            printf("   :  %d / %d \n", league_rank, leaderboard_size(LEADERBOARD_LEAGUE, 0));
+            printf("ٷλ : %.1f\n", percentile);
+        }
+        if (team_rank > 0) {
+            printf("   :  %d / %d \n", team_rank, leaderboard_size(LEADERBOARD_TEAM, player->team_id));
+        }
+    }
+    
     set_console_color(COLOR_HIGHLIGHT);
     printf("========================================\n");
     set_console_color(COLOR_DEFAULT);
@@ -60,21 +81,36 @@ void display_player_card(const Player* player) {
  * ƣʹðŶ룬ȫDev-C++ 5.11
  */
 void display_all_players_table() {
-    if (player_list == NULL) {                   /*  */
+    if (player_store.count == 0) {               /* մ洢 */
         set_console_color(COLOR_ERROR);          /* ôʾɫ */
         printf("\nǰϵͳûκԱݣ\n");
         set_console_color(COLOR_DEFAULT);        /* ָĬɫ */
         return;                                  /* ǰ */
     }
+    if (!ensure_player_indexes(0)) {             /* ֻӳģʽȺ˶Լ¼𻵵Ĳʾ */
+        set_console_color(COLOR_ERROR);
+        printf("\nڴ治㣬޷˶ļеļ¼\n");
+        set_console_color(COLOR_DEFAULT);
+        return;
+    }
     
     set_console_color(COLOR_HIGHLIGHT);
     printf("\n=====================    Ա   =====================\n");
     set_console_color(COLOR_DEFAULT);
     
-    Player* current = player_list;               /* ͷڵ㿪ʼ */
     int player_count = 0;                        /* Ա */
-    
-    while (current != NULL) {                    /*  */
+    float block_efficiency[EFFICIENCY_BATCH_BLOCK];   /* ǰһԱЧֵ */
+    
+    for (int i = 0; i < player_store.count; i++) {   /* ˳ɨ */
+        const Player* current = &player_store.records[i];
+        if (i % EFFICIENCY_BATCH_BLOCK == 0) {   /* ÿ鿪ʼʱЧֵ */
+            int n = player_store.count - i;
+            efficiency_batch_records(current, n < EFFICIENCY_BATCH_BLOCK ? n : EFFICIENCY_BATCH_BLOCK,
+                                     block_efficiency);
+        }
+        if (player_store_excluded(i)) {
+            continue;                            /* 𻵵ļ¼ַûн */
+        }
         player_count++;                          /*  */
         
         /* ʾԱ */
@@ -85,24 +121,21 @@ void display_all_players_table() {
         /* ʹù̶ʽðŶ룬ֶո */
         printf("ѧ    : %s\n", current->id);
         printf("    : %s\n", current->name);
-        printf("    : %s\n", current->team);
-        printf("λ    : %s\n", current->position);
+        printf("    : %s\n", team_pool_name(current->team_id));
+        printf("λ    : %s\n", position_name(current->position));
         printf("    : %d cm\n", current->height);
         printf("    : %d kg\n", current->weight);
         printf("    : #%d\n", current->jersey);
         
-        /* 㲢ʾЧֵ */
-        float efficiency = calculate_player_efficiency(current);
-        printf("Чֵ  : %.1f \n", efficiency);
+        /* ʾЧֵ */
+        printf("Чֵ  : %.1f \n", block_efficiency[i % EFFICIENCY_BATCH_BLOCK]);
         
         /* ʾָߣʹñ׼ASCIIַȷԣ */
-        if (current->next != NULL) {             /* һԱʱʾָ */
+        if (i + 1 < player_store.count) {        /* һԱʱʾָ */
             set_console_color(COLOR_BORDER);     /* ʹñ߿ɫ */
             printf("-----------------------------------------------\n");
             set_console_color(COLOR_DEFAULT);    /* ָĬɫ */
         }
-        
-        current = current->next;                 /* ƶһڵ */
     }
     
     /* ʾͳϢ */
@@ -116,85 +149,26 @@ void display_all_players_table() {
  * ߣgyx
  * ܣʾϸͳݱ
  * 
- * ƣͳƣʽɫ
+ * ƣͳȡɾͬµͳƻܣcurrent_league_stats
+ *       ֻʽɫ
  */
 void display_statistics_report() {
-    if (player_list == NULL) {                   /*  */
+    LeagueStats stats;                           /* ȫֱȡͳƻ */
+    current_league_stats(&stats);
+    if (stats.player_count == 0) {               /* մ洢飻ӳģʽ¼¼ȫδ */
         set_console_color(COLOR_ERROR);          /* ôʾɫ */
         printf("Աݿͳƣ\n");
         set_console_color(COLOR_DEFAULT);        /* ָĬɫ */
         return;                                  /* ǰ */
     }
     
-    Player* current = player_list;               /* ָʼ */
-    int total_players = 0;                       /* Ա */
-    int total_height = 0;                        /* ۼ */
-    int total_weight = 0;                        /* ۼ */
-    int max_height = 0, min_height = 300;        /* ߼ֵʼ */
-    int max_weight = 0, min_weight = 300;        /* ؼֵʼ */
-    Player* tallest = NULL, * shortest = NULL;   /* ֵԱָ */
-    Player* heaviest = NULL, * lightest = NULL;  /* ؼֵԱָ */
-    
-    /* һαռͳ */
-    while (current != NULL) {                    /*  */
-        total_players++;                         /* Ա */
-        total_height += current->height;         /* ۼ */
-        total_weight += current->weight;         /* ۼ */
-        
-        /* ߼ֵͶӦԱ */
-        if (current->height > max_height) {      /* µ */
-            max_height = current->height;        /* ֵ */
-            tallest = current;                   /* Աָ */
-        }
-        if (current->height < min_height) {      /* µС */
-            min_height = current->height;        /* Сֵ */
-            shortest = current;                  /* Աָ */
-        }
-        
-        /* ؼֵͶӦԱ */
-        if (current->weight > max_weight) {      /* µ */
-            max_weight = current->weight;        /* ֵ */
-            heaviest = current;                  /* Աָ */
-        }
-        if (current->weight < min_weight) {      /* µС */
-            min_weight = current->weight;        /* Сֵ */
-            lightest = current;                  /* Աָ */
-        }
-        
-        current = current->next;                 /* ƶһڵ */
-    }
-    
-    /* ƽֵ */
-    float avg_height = (float)total_height / total_players;
-    float avg_weight = (float)total_weight / total_players;
-    
-    /* ڶαͳƸλԱ */
-    current = player_list;                       /* ñָ */
-    int position_counts[5] = {0};                /* λüʼ */
-    
-    /* ޸λƶ壬Dev-C++ */
-    /* ʹ5ַ */
-    const char* pos1 = "PG";
-    const char* pos2 = "SG";
-    const char* pos3 = "SF";
-    const char* pos4 = "PF";
-    const char* pos5 = "C";
-    
-    while (current != NULL) {                    /* ٴα */
-        /* 5׼λ - Ƚ */
-        if (strcmp(current->position, pos1) == 0) {
-            position_counts[0]++;
-        } else if (strcmp(current->position, pos2) == 0) {
-            position_counts[1]++;
-        } else if (strcmp(current->position, pos3) == 0) {
-            position_counts[2]++;
-        } else if (strcmp(current->position, pos4) == 0) {
-            position_counts[3]++;
-        } else if (strcmp(current->position, pos5) == 0) {
-            position_counts[4]++;
-        }
-        current = current->next;                 /* ƶһڵ */
-    }
+    int total_players = stats.player_count;      /* Ա */
+    float avg_height = (float)stats.total_height / total_players;
+    float avg_weight = (float)stats.total_weight / total_players;
+    const Player* tallest = &player_store.records[stats.tallest];     /* ֵԱ */
+    const Player* shortest = &player_store.records[stats.shortest];
+    const Player* heaviest = &player_store.records[stats.heaviest];
+    const Player* lightest = &player_store.records[stats.lightest];
     
     /* ͳƱ */
     set_console_color(COLOR_HIGHLIGHT);          /* ñɫ */
@@ -211,15 +185,54 @@ void display_statistics_report() {
     printf("   Ա%s (%d kg)\n", heaviest->name, heaviest->weight);
     printf("   Ա%s (%d kg)\n", lightest->name, lightest->weight);
     printf("4. λ÷ֲ\n");
-    /* λ÷ֲʱҲʹö */
-    printf("   %s%d  (%.1f%%)\n", pos1, position_counts[0], 
-           (float)position_counts[0] / total_players * 100);
-    printf("   %s%d  (%.1f%%)\n", pos2, position_counts[1], 
-           (float)position_counts[1] / total_players * 100);
-    printf("   %s%d  (%.1f%%)\n", pos3, position_counts[2], 
-           (float)position_counts[2] / total_players * 100);
-    printf("   %s%d  (%.1f%%)\n", pos4, position_counts[3], 
-           (float)position_counts[3] / total_players * 100);
-    printf("   %s%d  (%.1f%%)\n", pos5, position_counts[4], 
-           (float)position_counts[4] / total_players * 100);
+    for (int position = 0; position < POSITION_COUNT; position++) {
+        printf("   %s%d  (%.1f%%)\n", position_name(position), stats.position_counts[position], 
+               (float)stats.position_counts[position] / total_players * 100);
+    }
+}
+
+/*
+ * display_efficiency_leaderboard
+ * ߣgyx
+ * ܣʾЧаһҳ
+ * scope - Χ, key - ӱŻλ, title - еķΧ,
+ *        first_rank - ҳʼλΣ1ʼ˳
+ * ֵҳʾ
+ * ƣȡɾͬµЧа񣨼leaderboard.hÿҳLEADERBOARD_PAGE_SIZEˣ
+ *       ԱƬ߲ͬͬУһͬʱһеΣ
+ *       ҳһпһҳĩβ֣ͬleaderboard_rank
+ */
+int display_efficiency_leaderboard(LeaderboardScope scope, int key, const char* title, int first_rank) {
+    PlayerHandle page[LEADERBOARD_PAGE_SIZE];
+    int total = leaderboard_size(scope, key);
+    int shown = leaderboard_page(scope, key, first_rank, LEADERBOARD_PAGE_SIZE, page);
+    
+    set_console_color(COLOR_HIGHLIGHT);
+    printf("\n========== %s Ча񣨵 %d-%d λ %d ˣ==========\n",
+           title, shown > 0 ? first_rank : 0, first_rank + shown - 1, total);
+    set_console_color(COLOR_DEFAULT);
+    
+    int rank = 0;                                /* ǰе */
+    int64_t previous_score = 0;                  /* һеЧʷ */
+    for (int i = 0; i < shown; i++) {
+        const Player* current = player_store_get(page[i]);
+        int64_t score = calculate_efficiency_score(current);
+        if (i == 0) {
+            rank = leaderboard_rank(scope, key, page[0], NULL);
+        } else if (score != previous_score) {
+            rank = first_rank + i;               /* ǰЧʷֶ */
+        }
+        previous_score = score;
+        if (rank <= 3) {                         /* ǰ */
+            set_console_color(COLOR_TITLE);
+        }
+        printf("%4d. %-12s %-20s %-12s %-3s %6.1f \n", rank, current->id, current->name,
+               team_pool_name(current->team_id), position_name(current->position),
+               calculate_player_efficiency(current));
+        set_console_color(COLOR_DEFAULT);
+    }
+    if (shown == 0) {
+        printf("ҳûԱ\n");
+    }
+    return shown;
 }
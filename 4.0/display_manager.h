@@ -2,6 +2,7 @@
 #define DISPLAY_MANAGER_H
 
 #include "data_struct.h"
+#include "leaderboard.h"
 
 /* Windows̨ɫ壨16ɫģʽ */
 #define COLOR_DEFAULT 7         /* Ĭϰɫǰ+ɫ */
@@ -45,4 +46,13 @@ void display_all_players_table();
  */
 void display_statistics_report();
 
+/*
+ * display_efficiency_leaderboard
+ * ܣʾЧаһҳLEADERBOARD_PAGE_SIZE
+ * scope - Χ, key - ӱŻλ, title - еķΧ,
+ *        first_rank - ҳʼλΣ1ʼ˳
+ * ֵҳʾ
+ */
+int display_efficiency_leaderboard(LeaderboardScope scope, int key, const char* title, int first_rank);
+
 #endif /* DISPLAY_MANAGER_H */
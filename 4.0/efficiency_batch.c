@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <string.h>
+#include "data_struct.h"
+#include "player_store.h"
+#include "efficiency_batch.h"
+
+#if defined(__x86_64__)
+#define EFFICIENCY_SIMD 1                       /* SSE2x86-64Ļָκ64λ֧ */
+#include <emmintrin.h>
+#endif
+
+/*
+ * ֻ16ֽڵSSE2δŻʱʱСջϣ
+ * 64λWindowsֻ֤ջ16ֽڶ룬GCCڸƽ̨Ϊ32ֽڵAVX¶ջGCC PR 54412
+ * δ32ֽջۻΥ32λջ16ֽڶҲֻ֤64λ
+ */
+
+/*
+ * λüȨ±Ϊλñ룬calculate_player_efficiencyеļȨһ
+ * ǷλΪ-0.0fx-0.0fԵxxΪ-0.0fΣ벻ӷֵĽλһ
+ */
+static const float position_bonus[256] = {
+    5.0f, 6.0f, 7.0f, 8.0f, 9.0f,               /* PG SG SF PF C */
+    [5 ... 255] = -0.0f
+};
+
+/*
+ * batch_scalar
+ * ܣ㣨κδãҲSIMDһβ
+ */
+static void batch_scalar(const int* height, const int* weight, const int* jersey,
+                         const uint8_t* position, int count, float* efficiency) {
+    for (int i = 0; i < count; i++) {
+        float value = (float)height[i] / 10.0f;
+        value += (200.0f - weight[i]) / 5.0f;
+        value += (float)jersey[i] / 2.0f;
+        value += position_bonus[position[i]];
+        efficiency[i] = value;
+    }
+}
+
+#ifdef EFFICIENCY_SIMD
+/*
+ * batch_sse2
+ * ܣSSE2ÿμ4
+ */
+static void batch_sse2(const int* height, const int* weight, const int* jersey,
+                       const uint8_t* position, int count, float* efficiency) {
+    const __m128 ten = _mm_set1_ps(10.0f), five = _mm_set1_ps(5.0f);
+    const __m128 two = _mm_set1_ps(2.0f), base = _mm_set1_ps(200.0f);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 h = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(height + i)));
+        __m128 w = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(weight + i)));
+        __m128 j = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(jersey + i)));
+        __m128 bonus = _mm_setr_ps(position_bonus[position[i]], position_bonus[position[i + 1]],
+                                   position_bonus[position[i + 2]], position_bonus[position[i + 3]]);
+        __m128 value = _mm_div_ps(h, ten);
+        value = _mm_add_ps(value, _mm_div_ps(_mm_sub_ps(base, w), five));
+        value = _mm_add_ps(value, _mm_div_ps(j, two));
+        value = _mm_add_ps(value, bonus);
+        _mm_storeu_ps(efficiency + i, value);
+    }
+    batch_scalar(height + i, weight + i, jersey + i, position + i, count - i, efficiency + i);
+}
+#endif
+
+/*
+ * efficiency_batch_columns
+ * ܣмһԱЧֵ
+ * height/weight/jersey/position - , count - Ա, efficiency - 
+ * ˵ʱȷ㺯ʱ⴦
+ */
+void efficiency_batch_columns(const int* height, const int* weight, const int* jersey,
+                              const uint8_t* position, int count, float* efficiency) {
+#ifdef EFFICIENCY_SIMD
+    batch_sse2(height, weight, jersey, position, count, efficiency);
+#else
+    batch_scalar(height, weight, jersey, position, count, efficiency);
+#endif
+}
+
+/*
+ * лһԱתúĸ
+ */
+typedef struct BatchColumns {
+    int height[EFFICIENCY_BATCH_BLOCK];
+    int weight[EFFICIENCY_BATCH_BLOCK];
+    int jersey[EFFICIENCY_BATCH_BLOCK];
+    uint8_t position[EFFICIENCY_BATCH_BLOCK];
+} BatchColumns;
+
+/*
+ * put_row
+ * ܣһԱдлĵi
+ */
+static void put_row(BatchColumns* columns, int i, const Player* player) {
+    columns->height[i] = player->height;
+    columns->weight[i] = player->weight;
+    columns->jersey[i] = player->jersey;
+    columns->position[i] = player->position;
+}
+
+/*
+ * efficiency_batch_records
+ * ܣһμ¼Чֵ
+ * records - ¼, count - ¼, efficiency - 
+ */
+void efficiency_batch_records(const Player* records, int count, float* efficiency) {
+    BatchColumns columns;
+    for (int first = 0; first < count; first += EFFICIENCY_BATCH_BLOCK) {
+        int n = count - first;
+        if (n > EFFICIENCY_BATCH_BLOCK) n = EFFICIENCY_BATCH_BLOCK;
+        for (int i = 0; i < n; i++) {
+            put_row(&columns, i, &records[first + i]);
+        }
+        efficiency_batch_columns(columns.height, columns.weight, columns.jersey, columns.position,
+                                 n, efficiency + first);
+    }
+}
+
+/*
+ * efficiency_batch_handles
+ * ܣһӦԱЧֵ
+ * handles - , count - , efficiency - 
+ */
+void efficiency_batch_handles(const PlayerHandle* handles, int count, float* efficiency) {
+    BatchColumns columns;
+    for (int first = 0; first < count; first += EFFICIENCY_BATCH_BLOCK) {
+        int n = count - first;
+        if (n > EFFICIENCY_BATCH_BLOCK) n = EFFICIENCY_BATCH_BLOCK;
+        for (int i = 0; i < n; i++) {
+            put_row(&columns, i, player_store_get(handles[first + i]));
+        }
+        efficiency_batch_columns(columns.height, columns.weight, columns.jersey, columns.position,
+                                 n, efficiency + first);
+    }
+}
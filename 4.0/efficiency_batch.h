@@ -0,0 +1,48 @@
+#ifndef EFFICIENCY_BATCH_H
+#define EFFICIENCY_BATCH_H
+
+#include <stdint.h>
+#include "data_struct.h"
+#include "player_store.h"
+
+/*
+ * Чֵģ
+ * һμһԱЧֵcalculate_player_efficiencyȫͬλһ£
+ * ͬ˳ͬĵ㣨ת㡢ӷǾȷIEEE㣩
+ * λüȨΪλñΪ±жϡ
+ * 64λSSE2ÿμ4x86-64ض֧SSE2㣻ʱȷʱ⴦
+ */
+
+#define EFFICIENCY_BATCH_BLOCK 1024      /* ¼ʱÿתóеԱ */
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * efficiency_batch_columns
+ * ܣмһԱЧֵ
+ * height/weight/jersey/position - , count - Ա,
+ *       efficiency - 飬iΪiԱЧֵ
+ * ˵ڶ߳ͬʱ
+ */
+void efficiency_batch_columns(const int* height, const int* weight, const int* jersey,
+                              const uint8_t* position, int count, float* efficiency);
+
+/*
+ * efficiency_batch_records
+ * ܣһμ¼Чֵ
+ * records - ¼, count - ¼, efficiency - 
+ * ˵ÿEFFICIENCY_BATCH_BLOCKתóкм
+ */
+void efficiency_batch_records(const Player* records, int count, float* efficiency);
+
+/*
+ * efficiency_batch_handles
+ * ܣһӦԱЧֵӻᣩ
+ * handles - 飨Ч, count - , efficiency - 
+ */
+void efficiency_batch_handles(const PlayerHandle* handles, int count, float* efficiency);
+
+#endif /* EFFICIENCY_BATCH_H */
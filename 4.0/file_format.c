@@ -0,0 +1,347 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include "crc32c.h"
+#include "file_format.h"
+
+/*
+ * ¼ֶβ֣ƫȰPlayerFileField˳
+ * ƫȡֵPlayerṹĳԱƫֶ֮ͬĿ϶̶0
+ */
+static const uint16_t record_field_offset[PLAYER_FILE_FIELD_COUNT] = {0, 8, 21, 42, 44, 48, 52, 56};
+static const uint16_t record_field_size[PLAYER_FILE_FIELD_COUNT] = {8, 13, 21, 2, 1, 4, 4, 4};
+
+/*
+ * ļͷֶεֽƫ
+ */
+#define HEADER_MAGIC 0
+#define HEADER_VERSION 8
+#define HEADER_ENDIAN_TAG 12
+#define HEADER_HEADER_SIZE 16
+#define HEADER_RECORD_SIZE 20
+#define HEADER_RECORD_COUNT 24
+#define HEADER_TEAM_COUNT 28
+#define HEADER_TEAM_ENTRY_SIZE 32
+#define HEADER_FIELD_COUNT 36
+#define HEADER_TEAM_TABLE_OFFSET 40
+#define HEADER_RECORD_OFFSET 48
+#define HEADER_FIELD_TABLE 56      /* ÿֶ4ֽڣƫ(2) + (2) */
+#define HEADER_TOMBSTONE_COUNT 88
+#define HEADER_FLAGS 92
+
+/*
+ * put_u16 / put_u32 / put_u64 / get_u16 / get_u32 / get_u64
+ * ܣСֽڶд뱾ֽ޹
+ */
+static void put_u16(unsigned char* p, uint16_t value) {
+    p[0] = (unsigned char)value;
+    p[1] = (unsigned char)(value >> 8);
+}
+
+static void put_u32(unsigned char* p, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static void put_u64(unsigned char* p, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static uint16_t get_u16(const unsigned char* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const unsigned char* p) {
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; i--) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+static uint64_t get_u64(const unsigned char* p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+/*
+ * file_format_init_header
+ * ܣǰʽдļͷ
+ * header - ļͷ, record_count - ¼, team_count - 
+ * ˵Ʊ֮ԤλΪPLAYER_FILE_TEAM_RESERVEı¼ʼ
+ */
+void file_format_init_header(PlayerFileHeader* header, int record_count, int team_count) {
+    memset(header, 0, sizeof(PlayerFileHeader));
+    header->version = PLAYER_FILE_VERSION;
+    header->header_size = PLAYER_FILE_HEADER_SIZE;
+    header->record_size = PLAYER_FILE_RECORD_SIZE;
+    header->record_count = (uint32_t)record_count;
+    header->team_count = (uint32_t)team_count;
+    header->team_entry_size = PLAYER_FILE_TEAM_ENTRY_SIZE;
+    header->team_table_offset = PLAYER_FILE_HEADER_SIZE;     /* Ʊļͷ */
+    int team_capacity = (team_count / PLAYER_FILE_TEAM_RESERVE + 1) * PLAYER_FILE_TEAM_RESERVE;  /* һλ */
+    header->record_offset = header->team_table_offset +
+                            (uint64_t)team_capacity * PLAYER_FILE_TEAM_ENTRY_SIZE;
+    for (int f = 0; f < PLAYER_FILE_FIELD_COUNT; f++) {
+        header->field_offset[f] = record_field_offset[f];
+        header->field_size[f] = record_field_size[f];
+    }
+}
+
+/*
+ * file_format_encode_header
+ * ܣļͷתΪPLAYER_FILE_HEADER_SIZEֽڴʽ
+ * header - ļͷ, bytes - 
+ */
+void file_format_encode_header(const PlayerFileHeader* header, unsigned char* bytes) {
+    memset(bytes, 0, PLAYER_FILE_HEADER_SIZE);  /* ֽ0 */
+    memcpy(bytes + HEADER_MAGIC, PLAYER_FILE_MAGIC, PLAYER_FILE_MAGIC_SIZE);
+    put_u32(bytes + HEADER_VERSION, header->version);
+    put_u32(bytes + HEADER_ENDIAN_TAG, PLAYER_FILE_ENDIAN_TAG);
+    put_u32(bytes + HEADER_HEADER_SIZE, header->header_size);
+    put_u32(bytes + HEADER_RECORD_SIZE, header->record_size);
+    put_u32(bytes + HEADER_RECORD_COUNT, header->record_count);
+    put_u32(bytes + HEADER_TEAM_COUNT, header->team_count);
+    put_u32(bytes + HEADER_TEAM_ENTRY_SIZE, header->team_entry_size);
+    put_u32(bytes + HEADER_FIELD_COUNT, PLAYER_FILE_FIELD_COUNT);
+    put_u64(bytes + HEADER_TEAM_TABLE_OFFSET, header->team_table_offset);
+    put_u64(bytes + HEADER_RECORD_OFFSET, header->record_offset);
+    for (int f = 0; f < PLAYER_FILE_FIELD_COUNT; f++) {
+        put_u16(bytes + HEADER_FIELD_TABLE + f * 4, header->field_offset[f]);
+        put_u16(bytes + HEADER_FIELD_TABLE + f * 4 + 2, header->field_size[f]);
+    }
+    put_u32(bytes + HEADER_TOMBSTONE_COUNT, header->tombstone_count);
+    put_u32(bytes + HEADER_FLAGS, header->flags);
+}
+
+/*
+ * file_format_decode_header
+ * ܣPLAYER_FILE_HEADER_SIZEֽڵļͷ
+ * bytes - ֽ, header - ļͷ
+ * ֵ1ʾħ汾ֶֽβ־ʶ0ʾǱɶĸʽ
+ * ˵ֶβֱ뱾һ£ļͷԱȱ汾ֱ
+ */
+int file_format_decode_header(const unsigned char* bytes, PlayerFileHeader* header) {
+    if (memcmp(bytes + HEADER_MAGIC, PLAYER_FILE_MAGIC, PLAYER_FILE_MAGIC_SIZE) != 0) {
+        return 0;                               /* ħ */
+    }
+    if (get_u32(bytes + HEADER_ENDIAN_TAG) != PLAYER_FILE_ENDIAN_TAG) {
+        return 0;                               /* ǰСдļ */
+    }
+    header->version = get_u32(bytes + HEADER_VERSION);
+    header->header_size = get_u32(bytes + HEADER_HEADER_SIZE);
+    header->record_size = get_u32(bytes + HEADER_RECORD_SIZE);
+    header->record_count = get_u32(bytes + HEADER_RECORD_COUNT);
+    header->team_count = get_u32(bytes + HEADER_TEAM_COUNT);
+    header->team_entry_size = get_u32(bytes + HEADER_TEAM_ENTRY_SIZE);
+    header->team_table_offset = get_u64(bytes + HEADER_TEAM_TABLE_OFFSET);
+    header->record_offset = get_u64(bytes + HEADER_RECORD_OFFSET);
+    header->tombstone_count = get_u32(bytes + HEADER_TOMBSTONE_COUNT);   /* ļ˴Ϊ0 */
+    header->flags = get_u32(bytes + HEADER_FLAGS);
+
+    if (header->version < PLAYER_FILE_MIN_VERSION ||
+        header->version > PLAYER_FILE_VERSION) return 0;            /* 汾֧ */
+    if (header->header_size < PLAYER_FILE_HEADER_SIZE) return 0;
+    if (header->record_size != PLAYER_FILE_RECORD_SIZE) return 0;
+    if (header->team_entry_size != PLAYER_FILE_TEAM_ENTRY_SIZE) return 0;
+    if (header->record_count > 0x7FFFFFFFu) return 0;                /* intΧ */
+    if (get_u32(bytes + HEADER_FIELD_COUNT) != PLAYER_FILE_FIELD_COUNT) return 0;
+    for (int f = 0; f < PLAYER_FILE_FIELD_COUNT; f++) {              /* ֶκ˶Բ */
+        header->field_offset[f] = get_u16(bytes + HEADER_FIELD_TABLE + f * 4);
+        header->field_size[f] = get_u16(bytes + HEADER_FIELD_TABLE + f * 4 + 2);
+        if (header->field_offset[f] != record_field_offset[f] ||
+            header->field_size[f] != record_field_size[f]) {
+            return 0;                           /* ֶβֲ */
+        }
+    }
+    if (header->team_table_offset < header->header_size ||
+        header->record_offset < header->team_table_offset +
+                                (uint64_t)header->team_count * header->team_entry_size) {
+        return 0;                               /* λûص */
+    }
+    return 1;
+}
+
+/*
+ * file_format_encode_footer
+ * ܣļβתΪPLAYER_FILE_FOOTER_SIZEֽڴʽ
+ * footer - ļβ, bytes - 
+ */
+void file_format_encode_footer(const PlayerFileFooter* footer, unsigned char* bytes) {
+    memset(bytes, 0, PLAYER_FILE_FOOTER_SIZE);
+    memcpy(bytes, PLAYER_FILE_FOOTER_MAGIC, 4);
+    put_u32(bytes + 4, footer->record_count);
+    put_u32(bytes + 8, footer->checksum);
+}
+
+/*
+ * file_format_decode_footer
+ * ܣPLAYER_FILE_FOOTER_SIZEֽڵļβ
+ * bytes - ֽ, footer - ļβ
+ * ֵ1ʾβħȷ0ʾļβ
+ */
+int file_format_decode_footer(const unsigned char* bytes, PlayerFileFooter* footer) {
+    if (memcmp(bytes, PLAYER_FILE_FOOTER_MAGIC, 4) != 0) {
+        return 0;
+    }
+    footer->record_count = get_u32(bytes + 4);
+    footer->checksum = get_u32(bytes + 8);
+    return 1;
+}
+
+/*
+ * file_format_encode_record
+ * ܣԱ¼תΪPLAYER_FILE_RECORD_SIZEֽڴʽ
+ * player - ڴ¼, bytes - 
+ */
+void file_format_encode_record(const Player* player, unsigned char* bytes) {
+    memset(bytes, 0, PLAYER_FILE_RECORD_SIZE);  /* ֶμ϶̶Ϊ0֤Уֵȶ */
+    put_u64(bytes + record_field_offset[FIELD_ID_KEY], player->id_key);
+    memcpy(bytes + record_field_offset[FIELD_ID], player->id, record_field_size[FIELD_ID]);
+    memcpy(bytes + record_field_offset[FIELD_NAME], player->name, record_field_size[FIELD_NAME]);
+    put_u16(bytes + record_field_offset[FIELD_TEAM_ID], player->team_id);
+    bytes[record_field_offset[FIELD_POSITION]] = player->position;
+    put_u32(bytes + record_field_offset[FIELD_HEIGHT], (uint32_t)player->height);
+    put_u32(bytes + record_field_offset[FIELD_WEIGHT], (uint32_t)player->weight);
+    put_u32(bytes + record_field_offset[FIELD_JERSEY], (uint32_t)player->jersey);
+    put_u32(bytes + PLAYER_FILE_RECORD_CRC_OFFSET, crc32c(bytes, PLAYER_FILE_RECORD_CRC_OFFSET));
+}
+
+/*
+ * file_format_decode_record
+ * ܣPLAYER_FILE_RECORD_SIZEֽڵԱ¼
+ * bytes - ֽ, player - ڴ¼
+ */
+void file_format_decode_record(const unsigned char* bytes, Player* player) {
+    memset(player, 0, sizeof(Player));
+    player->id_key = get_u64(bytes + record_field_offset[FIELD_ID_KEY]);
+    memcpy(player->id, bytes + record_field_offset[FIELD_ID], record_field_size[FIELD_ID]);
+    player->id[sizeof(player->id) - 1] = '\0';              /* ֹļ𻵵Խ */
+    memcpy(player->name, bytes + record_field_offset[FIELD_NAME], record_field_size[FIELD_NAME]);
+    player->name[sizeof(player->name) - 1] = '\0';
+    player->team_id = get_u16(bytes + record_field_offset[FIELD_TEAM_ID]);
+    player->position = bytes[record_field_offset[FIELD_POSITION]];
+    player->height = (int)get_u32(bytes + record_field_offset[FIELD_HEIGHT]);
+    player->weight = (int)get_u32(bytes + record_field_offset[FIELD_WEIGHT]);
+    player->jersey = (int)get_u32(bytes + record_field_offset[FIELD_JERSEY]);
+}
+
+/*
+ * file_format_encode_tombstone
+ * ܣһղۼ¼ռλȡʱ
+ * bytes - PLAYER_FILE_RECORD_SIZEֽ
+ * ˵ղ۵ӱųκƱڰ汾ȡʱͬ
+ */
+void file_format_encode_tombstone(unsigned char* bytes) {
+    memset(bytes, 0, PLAYER_FILE_RECORD_SIZE);
+    put_u16(bytes + record_field_offset[FIELD_TEAM_ID], (uint16_t)PLAYER_FILE_TOMBSTONE_TEAM);
+    put_u32(bytes + PLAYER_FILE_RECORD_CRC_OFFSET, crc32c(bytes, PLAYER_FILE_RECORD_CRC_OFFSET));
+}
+
+/*
+ * file_format_check_record
+ * ܣ˶һ¼ԴCRC32C
+ * header - ļͷ, bytes - ¼
+ * ֵ1ʾû2¼0ʾ¼
+ */
+int file_format_check_record(const PlayerFileHeader* header, const unsigned char* bytes) {
+    return header->version < 3 ||
+           crc32c(bytes, PLAYER_FILE_RECORD_CRC_OFFSET) == get_u32(bytes + PLAYER_FILE_RECORD_CRC_OFFSET);
+}
+
+/*
+ * file_format_record_checksum
+ * ܣȡһ¼ļУ͵Уֵ
+ * header - ļͷ, bytes - ¼
+ * ֵ3Ϊ¼ԴCRC32C2Ϊ¼FNV-1aֵ
+ */
+uint32_t file_format_record_checksum(const PlayerFileHeader* header, const unsigned char* bytes) {
+    return header->version < 3 ? file_format_checksum(bytes, PLAYER_FILE_RECORD_SIZE)
+                               : get_u32(bytes + PLAYER_FILE_RECORD_CRC_OFFSET);
+}
+
+/*
+ * file_format_team_checksum
+ * ܣȡһƼļУ͵Уֵ
+ * header - ļͷ, entry - Ʊ
+ * ֵ3ΪCRC32C2ΪFNV-1aֵ
+ */
+uint32_t file_format_team_checksum(const PlayerFileHeader* header, const unsigned char* entry) {
+    return header->version < 3 ? file_format_checksum(entry, PLAYER_FILE_TEAM_ENTRY_SIZE)
+                               : crc32c(entry, PLAYER_FILE_TEAM_ENTRY_SIZE);
+}
+
+/*
+ * file_format_checksum
+ * ܣһݵFNV-1aУֵ
+ * data - ׵ַ, size - ֽ
+ * ֵ32λУֵ
+ * ˵־¼2ļʹ
+ */
+uint32_t file_format_checksum(const void* data, size_t size) {
+    const unsigned char* p = (const unsigned char*)data;
+    uint32_t hash = 2166136261u;                /* FNVƫƻ */
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= 16777619u;                      /* FNV */
+    }
+    return hash;
+}
+
+/*
+ * file_format_record_offset
+ * ܣindex¼ļеƫ
+ * header - ļͷ, index - ¼±
+ * ֵֽƫ
+ */
+uint64_t file_format_record_offset(const PlayerFileHeader* header, int index) {
+    return header->record_offset + (uint64_t)index * header->record_size;
+}
+
+/*
+ * file_format_team_capacity
+ * ܣƱɵԤλ
+ * header - ļͷ
+ * ֵ
+ */
+int file_format_team_capacity(const PlayerFileHeader* header) {
+    return (int)((header->record_offset - header->team_table_offset) / header->team_entry_size);
+}
+
+/*
+ * file_format_file_size
+ * ܣļͷļӦеֽ
+ * header - ļͷ
+ * ֵֽ
+ */
+uint64_t file_format_file_size(const PlayerFileHeader* header) {
+    return file_format_record_offset(header, (int)header->record_count) + PLAYER_FILE_FOOTER_SIZE;
+}
+
+/*
+ * file_format_is_native
+ * ܣжϱPlayerṹֱܷӸļ¼ʹã㿽ӳǰᣩ
+ * 
+ * ֵ1ʾΪСҽṹСֶƫƾļһ£0ʾһ
+ */
+int file_format_is_native(void) {
+    const uint16_t probe = 1;                   /* СʱֽΪ1 */
+    if (*(const unsigned char*)&probe != 1) return 0;
+    if (sizeof(Player) != PLAYER_FILE_RECORD_SIZE) return 0;
+    const size_t member_offset[PLAYER_FILE_FIELD_COUNT] = {
+        offsetof(Player, id_key), offsetof(Player, id), offsetof(Player, name),
+        offsetof(Player, team_id), offsetof(Player, position), offsetof(Player, height),
+        offsetof(Player, weight), offsetof(Player, jersey)
+    };
+    for (int f = 0; f < PLAYER_FILE_FIELD_COUNT; f++) {
+        if (member_offset[f] != record_field_offset[f]) return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,191 @@
+#ifndef FILE_FORMAT_H
+#define FILE_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "data_struct.h"
+
+/*
+ * players.dat ļʽ3棩
+ * ļĲ˳ɣһɰС洢д޹أ
+ *   [ļͷ 96ֽ] [Ʊ team_count*32ֽ] [Ա¼ record_count*64ֽ] [ļβ 16ֽ]
+ * ļͷħ汾šֽǡִСƫơ¼ֶβֱ
+ * ƱĿ±꼴¼еӱ
+ * Ա¼ָ룬i¼λ record_offset + i*record_sizeֱӶλ
+ *           ֶƫڴеPlayerṹһ£С˻Ͽӳʹ
+ *           4ֽڣṹĩβλãΪǰ60ֽڵCRC32Ccrc32c.h
+ *           ʱ˶ԣָļ¼
+ * ļββħ¼УͣƱCRC32C¼ԴCRC32C֮ͣ
+ *         ڷƱ𻵡¼Уֵд¼λ
+ * ͵ظдdirty_tracker.hɾļ¼дΪղۣӱΪPLAYER_FILE_TOMBSTONE_TEAM
+ *           ¼¼׷ĩβƱԤλӿֱд룻
+ *           дڼļͷPLAYER_FILE_FLAG_PATCHINGǣʱļβУͲ
+ * 2ļֻͬǼ¼ĩβ4ֽΪ0УΪFNV-1aУֵ֮ͣԿɶȡ
+ *   ʱһдɵ3
+ * ħͷļ1棨ֱдṹľɸʽfile_ops.c
+ */
+
+#define PLAYER_FILE_MAGIC "PLAYERDB"         /* ļͷħ8ֽڲ */
+#define PLAYER_FILE_MAGIC_SIZE 8             /* ħ */
+#define PLAYER_FILE_VERSION 3                /* ǰļʽ汾 */
+#define PLAYER_FILE_MIN_VERSION 2            /* Կɶȡ汾ļͷĸʽ */
+#define PLAYER_FILE_ENDIAN_TAG 0x01020304u   /* ֽǣСд */
+#define PLAYER_FILE_HEADER_SIZE 96           /* ļͷֽ */
+#define PLAYER_FILE_TEAM_ENTRY_SIZE 32       /* Ʊÿֽ */
+#define PLAYER_FILE_TEAM_RESERVE 64          /* ƱȡıΪԤλ */
+#define PLAYER_FILE_RECORD_SIZE 64           /* ÿԱ¼ֽ */
+#define PLAYER_FILE_RECORD_CRC_OFFSET 60     /* ¼CRC32CƫƣУ鷶ΧΪǰȫֽ */
+#define PLAYER_FILE_FOOTER_SIZE 16           /* ļβֽ */
+#define PLAYER_FILE_FOOTER_MAGIC "PEND"      /* ļβħ4ֽ */
+#define PLAYER_FILE_FIELD_COUNT 8            /* ¼ֶ */
+#define PLAYER_FILE_TOMBSTONE_TEAM 0xFFFFu   /* ղۼ¼ӱţǺϷţ */
+#define PLAYER_FILE_FLAG_PATCHING 1u         /* ļͷǣھ͵ظд */
+
+/*
+ * ¼ֶαţֶβֱ˳򱣴ֶεƫ
+ */
+typedef enum PlayerFileField {
+    FIELD_ID_KEY = 0,       /* ѧ8ֽ */
+    FIELD_ID = 1,           /* ѧı13ֽ */
+    FIELD_NAME = 2,         /* 21ֽ */
+    FIELD_TEAM_ID = 3,      /* ӱţ2ֽ */
+    FIELD_POSITION = 4,     /* λñ룬1ֽ */
+    FIELD_HEIGHT = 5,       /* ߣ4ֽ */
+    FIELD_WEIGHT = 6,       /* أ4ֽ */
+    FIELD_JERSEY = 7        /* ºţ4ֽ */
+} PlayerFileField;
+
+/*
+ * ļͷڴʽϵֽмfile_format.c
+ */
+typedef struct PlayerFileHeader {
+    uint32_t version;               /* ʽ汾 */
+    uint32_t header_size;           /* ļͷֽ */
+    uint32_t record_size;           /* ÿ¼ֽ */
+    uint32_t record_count;          /* ¼ */
+    uint32_t team_count;            /* Ʊ */
+    uint32_t team_entry_size;       /* Ʊÿֽ */
+    uint64_t team_table_offset;     /* Ʊʼƫ */
+    uint64_t record_offset;         /* һ¼ʼƫ */
+    uint32_t tombstone_count;       /* ¼пղ۵ */
+    uint32_t flags;                 /* PLAYER_FILE_FLAG_* */
+    uint16_t field_offset[PLAYER_FILE_FIELD_COUNT];  /* ֶڼ¼ڵƫ */
+    uint16_t field_size[PLAYER_FILE_FIELD_COUNT];    /* ֶο */
+} PlayerFileHeader;
+
+/*
+ * ļβڴʽ
+ */
+typedef struct PlayerFileFooter {
+    uint32_t record_count;          /* ¼ڷֽض */
+    uint32_t checksum;              /* Ʊȫ¼У */
+} PlayerFileFooter;
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * file_format_init_header
+ * ܣǰʽдļͷ
+ * header - ļͷ, record_count - ¼, team_count - 
+ * ˵Ʊ֮ԤλΪPLAYER_FILE_TEAM_RESERVEı¼ʼ
+ */
+void file_format_init_header(PlayerFileHeader* header, int record_count, int team_count);
+
+/*
+ * file_format_encode_header / file_format_decode_header
+ * ܣļͷPLAYER_FILE_HEADER_SIZEֽڴʽ֮ת
+ * header - ļͷ, bytes - ֽ
+ * ֵdecode1ʾħ汾ֶֽβ־ʶ0ʾǱɶĸʽ
+ * ˵decodePLAYER_FILE_MIN_VERSIONPLAYER_FILE_VERSIONĸ汾
+ */
+void file_format_encode_header(const PlayerFileHeader* header, unsigned char* bytes);
+int file_format_decode_header(const unsigned char* bytes, PlayerFileHeader* header);
+
+/*
+ * file_format_encode_footer / file_format_decode_footer
+ * ܣļβPLAYER_FILE_FOOTER_SIZEֽڴʽ֮ת
+ * ֵdecode1ʾβħȷ0ʾļβ
+ */
+void file_format_encode_footer(const PlayerFileFooter* footer, unsigned char* bytes);
+int file_format_decode_footer(const unsigned char* bytes, PlayerFileFooter* footer);
+
+/*
+ * file_format_encode_record / file_format_decode_record
+ * ܣԱ¼PLAYER_FILE_RECORD_SIZEֽڴʽ֮ת
+ * player - ڴ¼, bytes - ֽ
+ * ˵ӱΪļƱ±ꣻеıֶα֤Խβ
+ *       encodeͬʱд¼ԴCRC32C
+ */
+void file_format_encode_record(const Player* player, unsigned char* bytes);
+void file_format_decode_record(const unsigned char* bytes, Player* player);
+
+/*
+ * file_format_encode_tombstone
+ * ܣһղۼ¼ռλȡʱ
+ * bytes - PLAYER_FILE_RECORD_SIZEֽ
+ */
+void file_format_encode_tombstone(unsigned char* bytes);
+
+/*
+ * file_format_check_record
+ * ܣ˶һ¼ԴCRC32C
+ * header - ļͷ汾жϼ¼ǷУֵ, bytes - ¼
+ * ֵ1ʾã2¼УֵǷ10ʾ¼
+ */
+int file_format_check_record(const PlayerFileHeader* header, const unsigned char* bytes);
+
+/*
+ * file_format_record_checksum / file_format_team_checksum
+ * ܣȡһ¼һƼļУ͵Уֵ
+ * header - ļͷ汾ѡ㷨, bytes - ¼Ʊ
+ * ֵ32λУֵ3¼ֱȡԴCRC32C¼
+ * ˵ļУǸУֵۼӣд¼ʱֻɼ
+ */
+uint32_t file_format_record_checksum(const PlayerFileHeader* header, const unsigned char* bytes);
+uint32_t file_format_team_checksum(const PlayerFileHeader* header, const unsigned char* entry);
+
+/*
+ * file_format_checksum
+ * ܣһݵFNV-1aУֵ
+ * data - ׵ַ, size - ֽ
+ * ֵ32λУֵ
+ * ˵־¼wal.h2ļʹ
+ */
+uint32_t file_format_checksum(const void* data, size_t size);
+
+/*
+ * file_format_record_offset
+ * ܣindex¼ļеƫ
+ * header - ļͷ, index - ¼±
+ * ֵֽƫ
+ */
+uint64_t file_format_record_offset(const PlayerFileHeader* header, int index);
+
+/*
+ * file_format_team_capacity
+ * ܣƱɵԤλ
+ * header - ļͷ
+ * ֵ
+ */
+int file_format_team_capacity(const PlayerFileHeader* header);
+
+/*
+ * file_format_file_size
+ * ܣļͷļӦеֽ
+ * header - ļͷ
+ * ֵֽ
+ */
+uint64_t file_format_file_size(const PlayerFileHeader* header);
+
+/*
+ * file_format_is_native
+ * ܣжϱPlayerṹֱܷӸļ¼ʹã㿽ӳǰᣩ
+ * 
+ * ֵ1ʾΪСҽṹСֶƫƾļһ£0ʾһ
+ */
+int file_format_is_native(void);
+
+#endif /* FILE_FORMAT_H */
@@ -1,115 +1,742 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <windows.h>
 #include "data_struct.h"
+#include "player_store.h"
+#include "player_manager.h"
+#include "team_pool.h"
+#include "file_format.h"
+#include "dirty_tracker.h"
+#include "parallel.h"
+#include "async_file.h"
+#include "legacy_format.h"
+#include "id_file_index.h"
 #include "file_ops.h"
 
-/* ȫԱͷָ붨 */
-Player* player_list = NULL;
+#define LOAD_CHUNK_RECORDS 8192     /* ʱÿȡļ¼ */
+#define PARALLEL_LOAD_MIN_RECORDS 65536   /* ÿ߳ٷֵļ¼ļСʱ̼߳ */
+#define SAVE_CHUNK_RECORDS 8192     /* ʱÿдļ¼512KB */
+
+/*
+ * ֻӳ״̬ļӳͼ׵ַδӳʱͼΪNULL
+ */
+static HANDLE mapped_file = INVALID_HANDLE_VALUE;
+static HANDLE mapped_section = NULL;
+static const unsigned char* mapped_view = NULL;
+static PlayerFileHeader mapped_header;           /* ӳļļͷ */
+static unsigned char* mapped_excluded = NULL;    /* ˶Ժ󲻵ǼĲλǣδ˶ʱΪNULL */
+static int mapped_excluded_count = 0;            /* ǵļ¼ */
+
+/*
+ * һμм¼ԴУֵļ¼ǰļλ
+ */
+static int corrupt_count = 0;
+static int corrupt_slots[CORRUPT_REPORT_LIMIT];
+
+/* λñıձ±꼴PlayerPositionöֵ */
+static const char* const position_names[POSITION_COUNT] = {"PG", "SG", "SF", "PF", "C"};
+
+/*
+ * pack_team_table
+ * ܣƳرļеƱ
+ * team_count - 
+ * ֵteam_count*PLAYER_FILE_TEAM_ENTRY_SIZEֽڵ»freeڴ治㷵NULL
+ */
+unsigned char* pack_team_table(int* team_count) {
+    *team_count = team_pool_count();
+    size_t size = (size_t)*team_count * PLAYER_FILE_TEAM_ENTRY_SIZE;
+    unsigned char* table = (unsigned char*)calloc(size > 0 ? size : 1, 1);
+    if (table == NULL) {
+        return NULL;
+    }
+    for (int t = 0; t < *team_count; t++) {
+        strncpy((char*)table + (size_t)t * PLAYER_FILE_TEAM_ENTRY_SIZE, team_pool_name(t),
+                PLAYER_FILE_TEAM_ENTRY_SIZE - 1);
+    }
+    return table;
+}
+
+/*
+ * write_player_snapshot
+ * ܣļ¼Ʊдļ
+ * filename - Ŀļ, records - ¼, count - ¼,
+ *       team_table - pack_team_tableƱ, team_count - 
+ * ֵ1ʾɹ0ʾʧ
+ * ˼·ǰʽдļͷƱԱ¼ļβ
+ *           ¼SAVE_CHUNK_RECORDSһд룬ͬʱۼУͣ
+ *           дΪ첽󣨼async_file.hһʱǰ漸д
+ *           дʱļֱ̣дʽ滻ԭļ
+ *           ;дʱԭļ滻Աдѧļid_file_index.h
+ * ˵ֻȡݣȫִ洢ں̨߳е
+ */
+int write_player_snapshot(const char* filename, const Player* records, int count,
+                          const unsigned char* team_table, int team_count) {
+    char temp_file[270];                     /* ʱļĿļ".tmp" */
+    snprintf(temp_file, sizeof(temp_file), "%s.tmp", filename);
+    AsyncFile* file = async_file_create(temp_file,   /* ԭļ滻֮ǰֲ */
+                                        (size_t)SAVE_CHUNK_RECORDS * PLAYER_FILE_RECORD_SIZE);
+    if (file == NULL) {                      /* ļʧܼ */
+        return 0;                            /* 0ʾʧ */
+    }
+    
+    unsigned char* bytes;                    /* д뻺едλ */
+    PlayerFileFooter footer;                 /* ļβ */
+    footer.record_count = (uint32_t)count;
+    footer.checksum = 0;
+    
+    /* һļͷ */
+    PlayerFileHeader header;
+    file_format_init_header(&header, count, team_count);
+    if ((bytes = async_file_reserve(file, PLAYER_FILE_HEADER_SIZE)) != NULL) {
+        file_format_encode_header(&header, bytes);
+    }
+    
+    /* ڶƱ±꼴ӱţԤλ0 */
+    for (int t = 0; t < file_format_team_capacity(&header); t++) {
+        if ((bytes = async_file_reserve(file, PLAYER_FILE_TEAM_ENTRY_SIZE)) == NULL) {
+            break;
+        }
+        if (t < team_count) {
+            memcpy(bytes, team_table + (size_t)t * PLAYER_FILE_TEAM_ENTRY_SIZE, PLAYER_FILE_TEAM_ENTRY_SIZE);
+            footer.checksum += file_format_team_checksum(&header, bytes);
+        } else {
+            memset(bytes, 0, PLAYER_FILE_TEAM_ENTRY_SIZE);
+        }
+    }
+    
+    /* Ա¼룬һʱǰ漸д */
+    for (int first = 0; first < count; first += SAVE_CHUNK_RECORDS) {
+        int n = count - first;
+        if (n > SAVE_CHUNK_RECORDS) n = SAVE_CHUNK_RECORDS;
+        if ((bytes = async_file_reserve(file, (size_t)n * PLAYER_FILE_RECORD_SIZE)) == NULL) {
+            break;
+        }
+        for (int i = 0; i < n; i++, bytes += PLAYER_FILE_RECORD_SIZE) {
+            file_format_encode_record(&records[first + i], bytes);
+            footer.checksum += file_format_record_checksum(&header, bytes);
+        }
+    }
+    
+    /* Ĳļβ */
+    if ((bytes = async_file_reserve(file, PLAYER_FILE_FOOTER_SIZE)) != NULL) {
+        file_format_encode_footer(&footer, bytes);
+    }
+    
+    /* 岽ʱļ̺滻ԭļ滻Ҳֱд */
+    int ok = async_file_close(file, 1);      /* ȴȫд겢 */
+    ok = ok && MoveFileExA(temp_file, filename, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+    if (!ok) {
+        DeleteFileA(temp_file);              /* ԭļֲ */
+        return 0;
+    }
+    id_file_index_write(filename, records, count, &footer);   /* ʧʱԭڣ˻ڴ */
+    return 1;
+}
+
+/*
+ * write_snapshot
+ * ܣڴеȫԱдļ
+ * filename - Ŀļ
+ * ֵ1ʾɹ0ʾʧ
+ */
+static int write_snapshot(const char* filename) {
+    int team_count;
+    unsigned char* team_table = pack_team_table(&team_count);
+    if (team_table == NULL) {
+        return 0;                            /* ڴ治 */
+    }
+    int ok = write_player_snapshot(filename, player_store.records, player_store.count,
+                                   team_table, team_count);
+    free(team_table);
+    return ok;
+}
 
 /*
  * save_player_data_to_file
- * ܣڴеԱݱ浽ļ
+ * ܣڴеԱݱ浽ļ
  * filename - Ŀļ
  * ֵɹļ¼ʧܷ0
- * ˼·öд뷽ʽ
  */
 int save_player_data_to_file(const char* filename) {
-    FILE* file_ptr = fopen(filename, "wb");  /* Զдģʽļ */
-    if (file_ptr == NULL) {                  /* ļʧܼ */
-        return 0;                            /* 0ʾʧ */
+    return write_snapshot(filename) ? player_store.count : 0;
+}
+
+/*
+ * load_legacy_records
+ * ܣȡ1ļľɰṹ壬ּlegacy_format.h
+ * file_ptr - ļ, file_size - ļֽ, layout - жϳļ¼
+ * ֵɹصļ¼
+ * ˼·ļС¼һԤ洢ռ䣬
+ *           ٰLOAD_CHUNK_RECORDSһ룬뵽ջϵʱ¼ֱ׷ӣ
+ *           Ϊ¼ڴ棻ĩβһĲȱݱ
+ */
+static int load_legacy_records(FILE* file_ptr, __int64 file_size, const LegacyLayout* layout) {
+    int record_count = (int)(file_size / layout->record_size);
+    if (record_count == 0 || _fseeki64(file_ptr, 0, SEEK_SET) != 0) return 0;
+    
+    int chunk_records = record_count < LOAD_CHUNK_RECORDS ? record_count : LOAD_CHUNK_RECORDS;
+    unsigned char* buffer = (unsigned char*)malloc((size_t)chunk_records * (size_t)layout->record_size);
+    if (buffer == NULL || !player_store_reserve(record_count)) {
+        free(buffer);                        /* ڴ治㣬洢Ϊ */
+        return 0;
+    }
+    
+    Player player;                           /* תڴ¼ */
+    char team[LEGACY_TEAM_SIZE];             /*  */
+    int loaded_count = 0;                    /* Ѽؼ¼ */
+    int failed = 0;                          /* תʧܱ */
+    while (loaded_count < record_count && !failed) {
+        int wanted = record_count - loaded_count;
+        if (wanted > chunk_records) wanted = chunk_records;
+        int got = (int)fread(buffer, (size_t)layout->record_size, (size_t)wanted, file_ptr);
+        for (int i = 0; i < got; i++) {
+            legacy_format_decode(layout, buffer + (size_t)i * (size_t)layout->record_size, &player, team);
+            int team_id = team_pool_intern(team);    /* ƵǼǵפ */
+            if (team_id < 0) {
+                failed = 1;                  /* ڴ治ӱþѼ */
+                break;
+            }
+            player.team_id = (uint16_t)team_id;
+            if (player_store_append(&player) == NULL) {
+                failed = 1;
+                break;
+            }
+            loaded_count++;                  /* ɹ */
+        }
+        if (got < wanted) {
+            break;                           /* ȡļض */
+        }
+    }
+    free(buffer);
+    return loaded_count;
+}
+
+/*
+ * Σһ̸߳¼Χ
+ * ͨļ¼д洢иԼĲλfirstʼص
+ */
+typedef struct LoadRange {
+    const char* filename;           /* ļ̷ֱ߳ */
+    const PlayerFileHeader* header; /* ļͷ */
+    const uint16_t* team_map;       /* ļӱ -> פ */
+    int* file_slots;                /* 洢λ -> ļλ */
+    int first;                      /* εһ¼ļλ */
+    int count;                      /* μ¼ */
+    int kept;                       /* ͨļ¼ */
+    int corrupt;                    /* Уֵļ¼ */
+    int corrupt_slots[CORRUPT_REPORT_LIMIT];   /* ǰļλ */
+    uint32_t checksum;              /* ڸ¼Уֵ֮ */
+    int ok;                         /* 1ʾȡ */
+} LoadRange;
+
+/*
+ * load_range
+ * ܣȡ벢һεļ¼ڼִ߳У
+ * ˵ֻȡפļͷ޸Ĺ״̬˸οͬʱ
+ */
+static void load_range(void* arg) {
+    LoadRange* range = (LoadRange*)arg;
+    const PlayerFileHeader* header = range->header;
+    int patching = (header->flags & PLAYER_FILE_FLAG_PATCHING) != 0;   /* джϵļ */
+    int team_count = (int)header->team_count;
+    range->kept = 0;
+    range->corrupt = 0;
+    range->checksum = 0;
+    range->ok = 0;
+    if (range->count == 0) {
+        range->ok = 1;
+        return;
     }
     
-    Player* current = player_list;           /* ͷڵ㿪ʼ */
-    int saved_count = 0;                     /* ѱ¼ */
+    AsyncFile* file = async_file_open_read(range->filename,   /* ÿ̶߳ȡ */
+                                           file_format_record_offset(header, range->first),
+                                           (uint64_t)range->count * PLAYER_FILE_RECORD_SIZE,
+                                           (size_t)LOAD_CHUNK_RECORDS * PLAYER_FILE_RECORD_SIZE);
+    Player* output = player_store.records + range->first;
+    int done = 0;                            /* Ѷļ¼ */
+    const unsigned char* buffer;             /* ǰ飬ʱ漸ڶ */
+    size_t size;
     
-    while (current != NULL) {                /* ֱĩβ */
-        size_t write_result = fwrite(current, sizeof(Player), 1, file_ptr);
-        if (write_result != 1) {             /* дʧܼ */
-            fclose(file_ptr);                /* رļ */
-            return 0;                        /* 0ʾʧ */
+    while (file != NULL && (buffer = async_file_next_block(file, &size)) != NULL) {
+        int n = (int)(size / PLAYER_FILE_RECORD_SIZE);
+        for (int i = 0; i < n; i++) {
+            const unsigned char* bytes = buffer + (size_t)i * PLAYER_FILE_RECORD_SIZE;
+            Player* player = &output[range->kept];
+            range->checksum += file_format_record_checksum(header, bytes);
+            if (!file_format_check_record(header, bytes)) {
+                if (!patching && range->corrupt < CORRUPT_REPORT_LIMIT) {
+                    range->corrupt_slots[range->corrupt] = range->first + done + i;
+                }
+                range->corrupt += !patching; /* джϵļдһļ¼ */
+                continue;
+            }
+            file_format_decode_record(bytes, player);
+            if (player->team_id >= team_count) {
+                continue;                    /* ӱԽ磬ü¼ */
+            }
+            player->team_id = range->team_map[player->team_id];
+            uint64_t key;                    /* ѧıΪ׼֮ʱ´ */
+            player->id_key = pack_player_id(player->id, &key) ? key : INVALID_PLAYER_KEY;
+            if (patching && !validate_player_data(player)) {
+                continue;                    /* дһļ¼ */
+            }
+            range->file_slots[range->first + range->kept] = range->first + done + i;
+            range->kept++;
         }
-        current = current->next;             /* ƶһڵ */
-        saved_count++;                       /* ɹ */
+        done += n;
     }
     
-    fclose(file_ptr);                        /* رļͷԴ */
-    return saved_count;                      /* سɹļ¼ */
+    range->ok = async_file_close(file, 0) && done == range->count;   /* ʧܺļض */
+}
+
+/*
+ * load_records
+ * ܣȡļͷʽ23棩ƱԱ¼ļβ
+ * file_ptr - Ѷļͷļ, filename - ļ̸߳Դ򿪣, header - ļͷ
+ * ֵɹصļ¼ļضϻУͲ-1
+ * ˵ļеӱžӳΪפţӱԽļ¼ղۣ
+ *       ¼ļλǼǵĶģ飬ӱ±һ²ܾ͵ظд
+ *       ͵ظджϵļдǣ˶ļβУֻ֤ͣͨļ¼
+ *       ȱʧĸĶɵط־룻
+ *       ļм¼ԴУֵļ¼¼ճأ
+ *       𻵵ļ¼corrupt_record_reportȡãʱУͲٿţļβֻ˶Լ¼
+ *       ´αд𻵵ļ¼ļУ
+ * ˼·¼iλÿֱ˼¼гΣ
+ *           ߳ͬʱ롢롢鲢ۼУֱֵд洢иԵĲλ
+ *           ȫǰƸβ뱻ļ¼УֵӼ¼Уͣ
+ *           ˳ȫͬļСʱֻһ߳
+ */
+static int load_records(FILE* file_ptr, const char* filename, const PlayerFileHeader* header) {
+    int patching = (header->flags & PLAYER_FILE_FLAG_PATCHING) != 0;   /* джϵļ */
+    int team_count = (int)header->team_count;
+    int record_count = (int)header->record_count;
+    size_t buffer_size = (size_t)team_count * PLAYER_FILE_TEAM_ENTRY_SIZE;
+    if (buffer_size < PLAYER_FILE_FOOTER_SIZE) {
+        buffer_size = PLAYER_FILE_FOOTER_SIZE;
+    }
+    unsigned char* buffer = (unsigned char*)malloc(buffer_size);  /* Ʊļβ */
+    uint16_t* team_map = (uint16_t*)malloc((size_t)(team_count > 0 ? team_count : 1) * sizeof(uint16_t));
+    int* file_slots = (int*)malloc((size_t)(record_count > 0 ? record_count : 1) * sizeof(int));
+    if (buffer == NULL || team_map == NULL || file_slots == NULL ||
+        !player_store_reserve(record_count)) {
+        free(buffer);
+        free(team_map);
+        free(file_slots);
+        return 0;                            /* ڴ治㣬洢Ϊ */
+    }
+    
+    uint32_t checksum = 0;                   /* ۼӵУ */
+    int loaded_count = 0;                    /* Ѽؼ¼ */
+    int ok = 1;                              /* ȡǷ */
+    
+    /* һƱǼǵפ */
+    ok = _fseeki64(file_ptr, (__int64)header->team_table_offset, SEEK_SET) == 0 &&
+         fread(buffer, PLAYER_FILE_TEAM_ENTRY_SIZE, (size_t)team_count, file_ptr) == (size_t)team_count;
+    for (int t = 0; ok && t < team_count; t++) {
+        unsigned char* entry = buffer + (size_t)t * PLAYER_FILE_TEAM_ENTRY_SIZE;
+        checksum += file_format_team_checksum(header, entry);
+        entry[PLAYER_FILE_TEAM_ENTRY_SIZE - 1] = '\0';
+        int team_id = team_pool_intern((const char*)entry);
+        if (team_id < 0) {
+            ok = 0;                          /* ڴ治ӱþ */
+            break;
+        }
+        team_map[t] = (uint16_t)team_id;
+        if (team_id != t) {
+            dirty_tracker_reset();           /* Ʊ´д */
+        }
+    }
+    
+    /* ڶԱ¼ηָ߳ */
+    LoadRange ranges[PARALLEL_MAX_WORKERS];
+    int workers = parallel_worker_count(record_count, PARALLEL_LOAD_MIN_RECORDS);
+    for (int w = 0; w < workers; w++) {
+        ranges[w].filename = filename;
+        ranges[w].header = header;
+        ranges[w].team_map = team_map;
+        ranges[w].file_slots = file_slots;
+        ranges[w].first = (int)((long long)record_count * w / workers);
+        ranges[w].count = (int)((long long)record_count * (w + 1) / workers) - ranges[w].first;
+    }
+    if (ok) {
+        parallel_run(load_range, ranges, sizeof(LoadRange), workers);
+    }
+    
+    /* 𻵵ļ¼ϲΣǰƲ뱻ļ¼ǼǾļλ */
+    for (int w = 0; ok && w < workers; w++) {
+        for (int c = 0; c < ranges[w].corrupt && c < CORRUPT_REPORT_LIMIT; c++) {
+            if (corrupt_count + c < CORRUPT_REPORT_LIMIT) {
+                corrupt_slots[corrupt_count + c] = ranges[w].corrupt_slots[c];
+            }
+        }
+        corrupt_count += ranges[w].corrupt;
+    }
+    for (int w = 0; ok && w < workers; w++) {
+        ok = ranges[w].ok;
+        checksum += ranges[w].checksum;
+        if (ranges[w].first != loaded_count) {
+            memmove(player_store.records + loaded_count, player_store.records + ranges[w].first,
+                    (size_t)ranges[w].kept * sizeof(Player));
+            memmove(file_slots + loaded_count, file_slots + ranges[w].first,
+                    (size_t)ranges[w].kept * sizeof(int));
+        }
+        loaded_count += ranges[w].kept;
+    }
+    if (ok) {
+        player_store_fill(loaded_count);
+        for (int i = 0; i < loaded_count; i++) {
+            dirty_tracker_bind(i, file_slots[i]);    /* 洢λ */
+        }
+    }
+    if (corrupt_count > 0) {
+        dirty_tracker_reset();               /* 𻵵ļ¼ܾ͵ر´д */
+    }
+    
+    /* Ĳļβ˶Լ¼Уͣ𻵵ļ¼ʱУͲţֻ˶Լ¼ */
+    PlayerFileFooter footer;
+    ok = ok && (patching ||
+                (_fseeki64(file_ptr, (__int64)file_format_record_offset(header, record_count), SEEK_SET) == 0 &&
+                 fread(buffer, PLAYER_FILE_FOOTER_SIZE, 1, file_ptr) == 1 &&
+                 file_format_decode_footer(buffer, &footer) &&
+                 footer.record_count == header->record_count &&
+                 (corrupt_count > 0 || footer.checksum == checksum)));
+    
+    free(buffer);
+    free(team_map);
+    free(file_slots);
+    return ok ? loaded_count : -1;
 }
 
 /*
  * load_player_data_from_file
- * ܣӶļԱݵڴ
+ * ܣӶļԱݵڴ洢
  * filename - Դļ
- * ֵɹصļ¼ļڷ0
- * ˼·ٴļȡؽ
+ * ֵɹصļ¼ļڷ0ļ𻵻ʽ޷ʶ𷵻-1
+ * ˼·ħͷİļͷʾ汾ȡжһֵ1ɲֺȡ
+ *           д洢ڴ棩ȡϺһؽȫ
+ *           ļͷɰ沼޷ʶʱݱֲ䣻Уʧʱ洢
  */
 int load_player_data_from_file(const char* filename) {
     FILE* file_ptr = fopen(filename, "rb");  /* Զƶģʽļ */
     if (file_ptr == NULL) {                  /* ļڻʧ */
         return 0;                            /* 0ʾݼ */
     }
+    setvbuf(file_ptr, NULL, _IONBF, 0);      /* ȡstdioת */
     
-    /* ֹڴй© */
-    Player* current = player_list;           /* ȡǰͷָ */
-    while (current != NULL) {                /*  */
-        Player* temp = current;              /* 浱ǰڵָ */
-        current = current->next;             /* ƶһڵ */
-        free(temp);                          /* ͷŵǰڵڴ */
+    /* һȷļСȡļͷ */
+    __int64 file_size = -1;                  /* ļֽ2GBʱlongŲ */
+    if (_fseeki64(file_ptr, 0, SEEK_END) == 0) {
+        file_size = _ftelli64(file_ptr);
     }
-    player_list = NULL;                      /* ͷָΪ */
-    
-    Player temp_buffer;                      /* ʱڶȡ */
-    Player* last_node = NULL;                /* ¼һڵ */
-    int loaded_count = 0;                    /* Ѽؼ¼ */
-    
-    /* ѭȡļеԱ¼ */
-    while (fread(&temp_buffer, sizeof(Player), 1, file_ptr) == 1) {
-        Player* new_node = (Player*)malloc(sizeof(Player));
-        if (new_node == NULL) {              /* ڴʧܼ */
-            break;                           /* ֹѭѼ */
+    if (file_size < 0 || _fseeki64(file_ptr, 0, SEEK_SET) != 0) {
+        fclose(file_ptr);                    /* ޷ȷļС */
+        return 0;
+    }
+    unsigned char header_bytes[PLAYER_FILE_HEADER_SIZE];
+    PlayerFileHeader header;
+    int is_current = 0;                      /* ǷΪļͷĸʽ2漰Ժ */
+    const LegacyLayout* legacy_layout = NULL;    /* 1ļļ¼֣ļΪNULL */
+    if (file_size >= PLAYER_FILE_HEADER_SIZE &&
+        fread(header_bytes, PLAYER_FILE_HEADER_SIZE, 1, file_ptr) == 1 &&
+        memcmp(header_bytes, PLAYER_FILE_MAGIC, PLAYER_FILE_MAGIC_SIZE) == 0) {
+        if (!file_format_decode_header(header_bytes, &header) ||
+            file_format_file_size(&header) > (uint64_t)file_size) {
+            fclose(file_ptr);                /* 汾ֻ֧ļض */
+            return -1;
         }
-        
-        memcpy(new_node, &temp_buffer, sizeof(Player));
-        new_node->next = NULL;               /* ½ڵnextָÿ */
-        
-        if (player_list == NULL) {           /* ΪʱĴ */
-            player_list = new_node;          /* ½ڵΪͷڵ */
-        } else {                             /* ǿʱĴ */
-            last_node->next = new_node;      /* ½ڵӵĩβ */
+        is_current = 1;
+    } else {
+        int recognized;
+        legacy_layout = legacy_format_detect(file_ptr, file_size, &recognized);
+        if (!recognized) {
+            fclose(file_ptr);                /* κһ֪ľɰ沼 */
+            return -1;
         }
-        last_node = new_node;                /* ĩβڵָ */
-        loaded_count++;                      /* ɹ */
+    }
+    
+    /* ڶݺ󰴸ʽȡ */
+    corrupt_count = 0;
+    unmap_player_data_file();                /* ˳ֻӳģʽ */
+    player_store_clear();                    /* м¼ڴ渴 */
+    team_pool_reset();                       /* ӱŰļ· */
+    if (is_current && header.version == PLAYER_FILE_VERSION &&
+        !(header.flags & PLAYER_FILE_FLAG_PATCHING)) {
+        dirty_tracker_begin(filename, &header);   /* ˺ĸĶɾ͵дظļ */
+    } else {
+        dirty_tracker_reset();               /* ɸʽджϣ´дΪǰʽ */
+    }
+    int loaded_count = 0;
+    if (is_current) {
+        loaded_count = load_records(file_ptr, filename, &header);
+    } else if (legacy_layout != NULL) {
+        loaded_count = load_legacy_records(file_ptr, file_size, legacy_layout);
+    }
+    if (loaded_count < 0) {
+        player_store_clear();                /* Уʧܣ */
+        team_pool_reset();
+        dirty_tracker_reset();
     }
     
     fclose(file_ptr);                        /* رļͷԴ */
+    rebuild_player_indexes();                /* ؽȫڴ治ʱƳٵ״ʹʱ */
     return loaded_count;                     /* سɹصļ¼ */
 }
 
 /*
- * validate_player_data
- * ܣ֤ԱݵԺͺϷ
+ * map_player_data_file
+ * ܣֻʽӳļͷļ洢ֱʹӳеļ¼㿽
+ * filename - ļ
+ * ֵӳļ¼ļڷ0
+ *         ļûļͷ1棩ѽضϡղۡƱ𻵻򱾻ṹ岼ֲʱ-1
+ * ˼·ֻȡļͷƱļβ¼κοɨ裬
+ *           ʱļС޹أƳٵ״βѯʱ
+ *           δڵѧļʱѧŲֱʹؽڴ
+ *           ӳͬһļʱϵͳҳ
+ * ע⣺ӳʱ˶Լ¼״νǰ˶Уֵӱţcheck_mapped_records
+ *       ϸļ¼Ǽκskipped_player_records
+ *       ļͷļβʱݱֲ䣬Ʊʱ洢
+ */
+int map_player_data_file(const char* filename) {
+    if (!file_format_is_native()) {
+        return -1;                              /* ¼޷ֱӸPlayer */
+    }
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return 0;                               /* ļڻ޷ */
+    }
+    
+    /* һӳļ */
+    LARGE_INTEGER file_size;
+    HANDLE section = NULL;
+    const unsigned char* view = NULL;
+    if (GetFileSizeEx(file, &file_size) && file_size.QuadPart >= PLAYER_FILE_HEADER_SIZE) {
+        section = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+    if (section != NULL) {
+        view = (const unsigned char*)MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0);
+    }
+    
+    /* ڶ˶ļͷļСļβ */
+    PlayerFileHeader header;
+    PlayerFileFooter footer;
+    int ok = view != NULL && file_format_decode_header(view, &header) &&
+             file_format_file_size(&header) <= (uint64_t)file_size.QuadPart &&
+             header.record_offset % sizeof(uint64_t) == 0 &&        /* ¼8ֽڶ */
+             header.tombstone_count == 0 && header.flags == 0 &&    /* ղۻᱻ¼ */
+             file_format_decode_footer(view + file_format_record_offset(&header, (int)header.record_count),
+                                       &footer) &&
+             footer.record_count == header.record_count;
+    for (uint32_t t = 0; ok && t < header.team_count; t++) {       /* ƱԽβ */
+        ok = view[header.team_table_offset + (uint64_t)t * PLAYER_FILE_TEAM_ENTRY_SIZE +
+                  PLAYER_FILE_TEAM_ENTRY_SIZE - 1] == '\0';
+    }
+    if (!ok) {
+        if (view != NULL) UnmapViewOfFile(view);
+        if (section != NULL) CloseHandle(section);
+        CloseHandle(file);
+        return -1;                              /* ǿӳļ */
+    }
+    
+    /* Ʊ˳µǼӣűļе±һ */
+    unmap_player_data_file();                   /* ͷһεӳ */
+    player_store_clear();
+    team_pool_reset();
+    dirty_tracker_reset();                      /* ֻģʽд */
+    for (uint32_t t = 0; ok && t < header.team_count; t++) {
+        const char* name = (const char*)view + header.team_table_offset +
+                           (uint64_t)t * PLAYER_FILE_TEAM_ENTRY_SIZE;
+        ok = team_pool_intern(name) == (int)t;  /* þʱŻλ */
+    }
+    if (!ok) {
+        team_pool_reset();
+        rebuild_player_indexes();
+        UnmapViewOfFile(view);
+        CloseHandle(section);
+        CloseHandle(file);
+        return -1;                              /* Ʊ */
+    }
+    
+    /* Ĳ洢ֱָӳеļ¼ */
+    mapped_file = file;
+    mapped_section = section;
+    mapped_view = view;
+    mapped_header = header;
+    corrupt_count = 0;                          /* 𻵵ļ¼ں˶ʱǼ */
+    player_store_attach((const Player*)(view + header.record_offset), (int)header.record_count);
+    defer_player_indexes();                     /* ״βѯʱٽ */
+    id_file_index_open(filename, &footer);      /* ѧŲʹļ */
+    return (int)header.record_count;
+}
+
+/*
+ * unmap_player_data_file
+ * ܣ˳ֻӳģʽͷӳ䣬洢ָΪյĿд״̬
+ * 
+ */
+void unmap_player_data_file(void) {
+    if (mapped_view == NULL) {
+        return;                                 /* δӳģʽ */
+    }
+    player_store_detach();
+    id_file_index_close();
+    free(mapped_excluded);
+    mapped_excluded = NULL;
+    mapped_excluded_count = 0;
+    UnmapViewOfFile(mapped_view);
+    CloseHandle(mapped_section);
+    CloseHandle(mapped_file);
+    mapped_view = NULL;
+    mapped_section = NULL;
+    mapped_file = INVALID_HANDLE_VALUE;
+}
+
+/*
+ * check_mapped_records
+ * ܣ˶ӳеļ¼УֵӱԽļ¼ΪǼ
+ * 
+ * ֵǵļ¼δӳģʽ0ڴ治㷵-1
+ * ˵ÿӳֻ˶һΣ˺ֱӷϴεĽУֵļ¼corrupt_record_report
+ *       𻵵ļ¼ַûнڽѧš֮ǰų
+ */
+int check_mapped_records(void) {
+    if (mapped_view == NULL || mapped_excluded != NULL) {
+        return mapped_excluded_count;           /* δӳѺ˶Թ */
+    }
+    int count = player_store.count;
+    unsigned char* marks = (unsigned char*)calloc(count > 0 ? (size_t)count : 1, 1);
+    if (marks == NULL) {
+        return -1;
+    }
+    int marked = 0;                             /* ǵļ¼ */
+    for (int i = 0; i < count; i++) {
+        if (!file_format_check_record(&mapped_header,
+                                      mapped_view + file_format_record_offset(&mapped_header, i))) {
+            if (corrupt_count < CORRUPT_REPORT_LIMIT) {
+                corrupt_slots[corrupt_count] = i;
+            }
+            corrupt_count++;
+        } else if (player_store.records[i].team_id < team_pool_count()) {
+            continue;                           /* ϸļ¼ */
+        }
+        marks[i] = 1;
+        marked++;
+    }
+    mapped_excluded = marks;
+    mapped_excluded_count = marked;
+    player_store_exclude(marks);
+    return marked;
+}
+
+/*
+ * mapped_record_intact
+ * ܣ˶ӳһ¼ԴУֵ
+ * slot - λ±
+ * ֵ1ʾûδӳģʽ0ʾ¼
+ * ˵ѧļʱֻ˶ҵһصȫ¼˶
+ */
+int mapped_record_intact(int slot) {
+    return mapped_view == NULL ||
+           file_format_check_record(&mapped_header,
+                                    mapped_view + file_format_record_offset(&mapped_header, slot));
+}
+
+/*
+ * corrupt_record_report
+ * ܣȡһμм¼ԴУֵļ¼
+ * slots - ǰ𻵼¼ļеţ0ʼ򣩣CORRUPT_REPORT_LIMIT
+ *        ֻʱΪNULL
+ * ֵ𻵼¼ûʱ0
+ */
+int corrupt_record_report(int* slots) {
+    int listed = corrupt_count < CORRUPT_REPORT_LIMIT ? corrupt_count : CORRUPT_REPORT_LIMIT;
+    if (slots != NULL) {
+        memcpy(slots, corrupt_slots, (size_t)listed * sizeof(int));
+    }
+    return corrupt_count;
+}
+
+/*
+ * validate_player_fields
+ * ܣ֤ӱȫֶ
  * player - ֤Աṹָ
- * ֵ1ʾݺϷ0ʾݷǷ
- * ֤ѧ12λǿաںΧºЧ
+ * ֵ1ʾϷ0ʾǷ
+ * ˵ڴ֤֮ͨŵǼǵפ
+ *       򱻾ܾҲռһӱ
  */
-int validate_player_data(const Player* player) {
-    if (strlen(player->id) != 12) return 0;    /* ѧűΪ12λ */
+int validate_player_fields(const Player* player) {
+    uint64_t key;                               /* ѧ´ */
+    if (!pack_player_id(player->id, &key)) return 0;   /* ѧűΪ12λ */
+    if (key != player->id_key) return 0;       /* ѧһ */
     if (strlen(player->name) == 0) return 0;   /* Ϊַ */
     if (player->height < 100 || player->height > 250) return 0; /* ߷Χ */
     if (player->weight < 40 || player->weight > 200) return 0;  /* طΧ */
     if (player->jersey < 0 || player->jersey > 99) return 0;    /* ºŷΧ */
+    if (player->position >= POSITION_COUNT) return 0;          /* λñ5׼λ֮һ */
     
-    /* ֤λǷϷ5׼λ֮һ */
-    const char* valid_positions[] = {"PG", "SG", "SF", "PF", "C"};
-    int position_valid = 0;                     /* λЧԱ־ */
-    for (int i = 0; i < 5; i++) {               /* Ϸλ */
-        if (strcmp(player->position, valid_positions[i]) == 0) {
-            position_valid = 1;                 /* ҵƥλãЧ */
-            break;                              /* ǰѭ */
+    return 1;
+}
+
+/*
+ * validate_player_data
+ * ܣ֤ԱݵԺͺϷ
+ * player - ֤Աṹָ
+ * ֵ1ʾݺϷ0ʾݷǷ
+ * ֤ѧ12λһ¡ǿաӱѵǼǡ
+ *           ںΧºЧλñϷ
+ */
+int validate_player_data(const Player* player) {
+    if (player->team_id >= team_pool_count()) return 0;        /* ӱűѵǼ */
+    return validate_player_fields(player);      /* ֶ */
+}
+
+/*
+ * pack_player_id
+ * ܣ12λѧŴΪ64λ
+ * id - ѧַ, key - 
+ * ֵ1ʾɹ0ʾѧŲ12λ
+ * ˼·ѧŶ12λʮֵɱ֤һһӦֵС2^40
+ */
+int pack_player_id(const char* id, uint64_t* key) {
+    uint64_t value = 0;                         /* ۼӵʮֵ */
+    for (int i = 0; i < 12; i++) {              /* λ鲢ۼ */
+        if (id[i] < '0' || id[i] > '9') {
+            return 0;                           /* ַ򳤶Ȳ */
         }
+        value = value * 10 + (uint64_t)(id[i] - '0');
     }
-    if (!position_valid) return 0;              /* λЧش */
-    
-    return 1;                                   /* ֤ͨسɹ */
+    if (id[12] != '\0') {
+        return 0;                               /* ȳ12λ */
+    }
+    *key = value;
+    return 1;
+}
+
+/*
+ * position_from_name
+ * ܣλı(PG/SG/SF/PF/C)תΪλñ
+ * name - λı
+ * ֵPlayerPositionöֵıǷPOSITION_INVALID
+ */
+int position_from_name(const char* name) {
+    for (int i = 0; i < POSITION_COUNT; i++) {  /* Ϸλöձ */
+        if (strcmp(name, position_names[i]) == 0) {
+            return i;                           /* ҵƥλ */
+        }
+    }
+    return POSITION_INVALID;                    /* λıǷ */
+}
+
+/*
+ * position_name
+ * ܣλñתΪλı
+ * position - λñ
+ * ֵλıǷ"?"
+ */
+const char* position_name(int position) {
+    if (position < 0 || position >= POSITION_COUNT) {
+        return "?";                             /* Ƿ */
+    }
+    return position_names[position];
 }
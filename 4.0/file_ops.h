@@ -3,6 +3,8 @@
 
 #include "data_struct.h"
 
+#define CORRUPT_REPORT_LIMIT 16          /* ʱг𻵼¼ */
+
 /*
  * 
  * кϸĲ˵͹
@@ -10,20 +12,99 @@
 
 /*
  * save_player_data_to_file
- * ܣڴеԱݱ浽ļ
+ * ܣڴеԱݱ浽ļ
  * filename - Ŀļ
  * ֵɹļ¼ʧܷ0
+ * ˵һɰǰʽfile_format.h棻дʱļ滻ʧʱԭļ
  */
 int save_player_data_to_file(const char* filename);
 
+/*
+ * pack_team_table
+ * ܣƳرļеƱ
+ * team_count - 
+ * ֵ·ıfreeڴ治㷵NULL
+ */
+unsigned char* pack_team_table(int* team_count);
+
+/*
+ * write_player_snapshot
+ * ܣļ¼Ʊдļ
+ * filename - Ŀļ, records - ¼, count - ¼,
+ *       team_table - pack_team_tableƱ, team_count - 
+ * ֵ1ʾɹ0ʾʧܣԭļֲ䣩
+ * ˵дfilename.tmp̣滻ԭļ
+ *       ȫִ洢¼ƱΪʱں̨߳еãcheckpoint.h
+ */
+int write_player_snapshot(const char* filename, const Player* records, int count,
+                          const unsigned char* team_table, int team_count);
+
 /*
  * load_player_data_from_file
- * ܣӶļԱݵڴ
+ * ܣӶļԱݵڴ洢
  * filename - Դļ
- * ֵɹصļ¼ļڷ0
+ * ֵɹصļ¼ļڷ0ļ𻵻ʽ޷ʶ𷵻-1
+ * ˵ͬʱִ֧ļͷĸʽ23棬file_format.h1ɸʽ
+ *       1水ļСֶԶжһдĲ֣legacy_format.h
+ *       ´αʱдΪǰʽ
+ *       3ļ˶Լ¼ԴУֵ𻵵ļ¼ճأ
+ *       ֵΪصļ¼𻵵ļ¼corrupt_record_report
  */
 int load_player_data_from_file(const char* filename);
 
+/*
+ * map_player_data_file
+ * ܣֻʽӳļͷļ洢ֱʹӳеļ¼㿽
+ * filename - ļ
+ * ֵӳļ¼ļڷ0ļ޷ӳ䷵-1
+ * ˵ӳڼ洢ֻģʽɾľܾ
+ *       ¼Уֵ״νǰź˶ԣcheck_mapped_records
+ *       ٴεload_player_data_from_fileunmap_player_data_file˳ӳģʽ
+ */
+int map_player_data_file(const char* filename);
+
+/*
+ * unmap_player_data_file
+ * ܣ˳ֻӳģʽͷӳ䣬洢ָΪյĿд״̬
+ * 
+ */
+void unmap_player_data_file(void);
+
+/*
+ * check_mapped_records
+ * ܣ˶ӳеļ¼УֵӱԽļ¼ΪǼ
+ * 
+ * ֵǵļ¼δӳģʽ0ڴ治㷵-1
+ * ˵ÿӳֻ˶һΣ˺ֱӷϴεĽ
+ *       Ǽplayer_store_excludedУֵļ¼corrupt_record_report
+ */
+int check_mapped_records(void);
+
+/*
+ * mapped_record_intact
+ * ܣ˶ӳһ¼ԴУֵ
+ * slot - λ±
+ * ֵ1ʾûδӳģʽ0ʾ¼
+ */
+int mapped_record_intact(int slot);
+
+/*
+ * corrupt_record_report
+ * ܣȡһμأӳ˶ԣм¼ԴУֵļ¼
+ * slots - ǰ𻵼¼ļеţ0ʼ򣩣CORRUPT_REPORT_LIMIT
+ *        ֻʱΪNULL
+ * ֵ𻵼¼ûʱ0
+ */
+int corrupt_record_report(int* slots);
+
+/*
+ * validate_player_fields
+ * ܣ֤ӱȫֶΣ֤ͨŵǼǣ
+ * player - ֤Աṹָ
+ * ֵ1ʾϷ0ʾǷ
+ */
+int validate_player_fields(const Player* player);
+
 /*
  * validate_player_data
  * ܣ֤ԱݵԺͺϷ
@@ -32,4 +113,28 @@ int load_player_data_from_file(const char* filename);
  */
 int validate_player_data(const Player* player);
 
+/*
+ * pack_player_id
+ * ܣ12λѧŴΪ64λ
+ * id - ѧַ, key - 
+ * ֵ1ʾɹ0ʾѧŲ12λ
+ */
+int pack_player_id(const char* id, uint64_t* key);
+
+/*
+ * position_from_name
+ * ܣλı(PG/SG/SF/PF/C)תΪλñ
+ * name - λı
+ * ֵPlayerPositionöֵıǷPOSITION_INVALID
+ */
+int position_from_name(const char* name);
+
+/*
+ * position_name
+ * ܣλñתΪλı
+ * position - λñ
+ * ֵλıǷ"?"
+ */
+const char* position_name(int position);
+
 #endif /* FILE_OPS_H */
@@ -0,0 +1,414 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+#include "data_struct.h"
+#include "file_format.h"
+#include "async_file.h"
+#include "id_file_index.h"
+
+#define INDEX_MAGIC "PLAYRIDX"               /* ļͷħ8ֽڲ */
+#define INDEX_VERSION 1                      /* ļʽ汾 */
+#define INDEX_HEADER_SIZE 32                 /* ļͷֽ */
+#define INDEX_ENTRY_SIZE 16                  /* ÿֽ */
+#define INDEX_ENTRIES_PER_PAGE (ID_FILE_INDEX_PAGE_SIZE / INDEX_ENTRY_SIZE)
+#define INDEX_WRITE_BLOCK (16 * ID_FILE_INDEX_PAGE_SIZE)   /* дʱÿֽ */
+
+/* ļͷֶƫ */
+#define HEADER_VERSION 8
+#define HEADER_ENTRY_COUNT 12
+#define HEADER_FENCE_COUNT 16
+#define HEADER_ENTRY_OFFSET 20
+#define HEADER_DATA_RECORDS 24
+#define HEADER_DATA_CHECKSUM 28
+
+/*
+ * ڴедǰã
+ */
+typedef struct IndexEntry {
+    uint64_t key;                   /* ѧ */
+    int slot;                       /* ļλ */
+} IndexEntry;
+
+/*
+ * ӳ״̬ļӳͼ׵ַδʱͼΪNULL
+ */
+static HANDLE index_file = INVALID_HANDLE_VALUE;
+static HANDLE index_section = NULL;
+static const unsigned char* index_view = NULL;
+static const unsigned char* index_fences = NULL;    /* ҳ */
+static const unsigned char* index_entries = NULL;   /* һ */
+static int index_entry_count = 0;
+static int index_fence_count = 0;
+
+/*
+ * put_u32 / put_u64 / get_u32 / get_u64
+ * ܣСֽڶд뱾ֽ޹
+ */
+static void put_u32(unsigned char* p, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static void put_u64(unsigned char* p, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static uint32_t get_u32(const unsigned char* p) {
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; i--) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+static uint64_t get_u64(const unsigned char* p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+/*
+ * index_path
+ * ܣļõļ
+ */
+static void index_path(const char* data_file, char* path, size_t size) {
+    snprintf(path, size, "%s%s", data_file, ID_FILE_INDEX_SUFFIX);
+}
+
+/*
+ * fence_count_for / entry_offset_for
+ * ܣҳʼƫƣҳ߽룬ÿҳǡһҳϣ
+ */
+static int fence_count_for(int entry_count) {
+    return (entry_count + INDEX_ENTRIES_PER_PAGE - 1) / INDEX_ENTRIES_PER_PAGE;
+}
+
+static uint64_t entry_offset_for(int fence_count) {
+    uint64_t end = INDEX_HEADER_SIZE + (uint64_t)fence_count * sizeof(uint64_t);
+    return (end + ID_FILE_INDEX_PAGE_SIZE - 1) / ID_FILE_INDEX_PAGE_SIZE * ID_FILE_INDEX_PAGE_SIZE;
+}
+
+/*
+ * compare_entries
+ * ܣqsortȽϺѧ
+ */
+static int compare_entries(const void* a, const void* b) {
+    uint64_t ka = ((const IndexEntry*)a)->key, kb = ((const IndexEntry*)b)->key;
+    return (ka > kb) - (ka < kb);
+}
+
+/*
+ * reserve_zero
+ * ܣд뻺дsizeֽڵ0sizeINDEX_WRITE_BLOCK
+ */
+static int reserve_zero(AsyncFile* file, size_t size) {
+    unsigned char* bytes = size > 0 ? async_file_reserve(file, size) : NULL;
+    if (bytes != NULL) {
+        memset(bytes, 0, size);
+    }
+    return size == 0 || bytes != NULL;
+}
+
+/*
+ * write_index
+ * ܣдļ
+ * data_file - ļ, entries - ͵, count - , footer - ļβ
+ * ֵ1ʾɹ0ʾʧ
+ * ˼·дʱļ̣滻ԭ;ʱԭѹڣ
+ */
+static int write_index(const char* data_file, IndexEntry* entries, int count,
+                       const PlayerFileFooter* footer) {
+    qsort(entries, (size_t)count, sizeof(IndexEntry), compare_entries);
+    
+    char path[270], temp_file[280];
+    index_path(data_file, path, sizeof(path));
+    snprintf(temp_file, sizeof(temp_file), "%s.tmp", path);
+    AsyncFile* file = async_file_create(temp_file, INDEX_WRITE_BLOCK);
+    if (file == NULL) {
+        return 0;
+    }
+    
+    /* һļͷ */
+    int fence_count = fence_count_for(count);
+    uint64_t entry_offset = entry_offset_for(fence_count);
+    unsigned char* bytes = async_file_reserve(file, INDEX_HEADER_SIZE);
+    if (bytes != NULL) {
+        memset(bytes, 0, INDEX_HEADER_SIZE);
+        memcpy(bytes, INDEX_MAGIC, 8);
+        put_u32(bytes + HEADER_VERSION, INDEX_VERSION);
+        put_u32(bytes + HEADER_ENTRY_COUNT, (uint32_t)count);
+        put_u32(bytes + HEADER_FENCE_COUNT, (uint32_t)fence_count);
+        put_u32(bytes + HEADER_ENTRY_OFFSET, (uint32_t)entry_offset);
+        put_u32(bytes + HEADER_DATA_RECORDS, footer->record_count);
+        put_u32(bytes + HEADER_DATA_CHECKSUM, footer->checksum);
+    }
+    
+    /* ڶҳ䵽ҳ߽ */
+    for (int p = 0; p < fence_count; p++) {
+        if ((bytes = async_file_reserve(file, sizeof(uint64_t))) == NULL) break;
+        put_u64(bytes, entries[p * INDEX_ENTRIES_PER_PAGE].key);
+    }
+    reserve_zero(file, (size_t)(entry_offset - INDEX_HEADER_SIZE - (uint64_t)fence_count * sizeof(uint64_t)));
+    
+    /*  */
+    for (int i = 0; i < count; i++) {
+        if ((bytes = async_file_reserve(file, INDEX_ENTRY_SIZE)) == NULL) break;
+        put_u64(bytes, entries[i].key);
+        put_u32(bytes + 8, (uint32_t)entries[i].slot);
+        put_u32(bytes + 12, 0);
+    }
+    
+    int ok = async_file_close(file, 1);
+    ok = ok && MoveFileExA(temp_file, path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+    if (!ok) {
+        DeleteFileA(temp_file);
+    }
+    return ok;
+}
+
+/*
+ * id_file_index_write
+ * ܣдļļ
+ * data_file - ļ, records - ļλ˳еļ¼, count - ¼,
+ *       footer - ļļβ
+ * ֵ1ʾɹ0ʾʧ
+ */
+int id_file_index_write(const char* data_file, const Player* records, int count,
+                        const PlayerFileFooter* footer) {
+    IndexEntry* entries = (IndexEntry*)malloc((size_t)(count > 0 ? count : 1) * sizeof(IndexEntry));
+    if (entries == NULL) {
+        return 0;                                   /* ڴ治㣬ԭڲʹ */
+    }
+    int used = 0;
+    for (int i = 0; i < count; i++) {
+        if (records[i].id_key != INVALID_PLAYER_KEY) {
+            entries[used].key = records[i].id_key;
+            entries[used].slot = i;
+            used++;
+        }
+    }
+    int ok = write_index(data_file, entries, used, footer);
+    free(entries);
+    return ok;
+}
+
+/*
+ * read_header
+ * ܣļͷ˶ļβļСǷһ
+ * bytes - ļͷ, file_size - ļֽ, footer - ǰļβ,
+ *       entry_count/fence_count/entry_offset - 
+ * ֵ1ʾã0ʾ𻵻ѹ
+ */
+static int read_header(const unsigned char* bytes, uint64_t file_size, const PlayerFileFooter* footer,
+                       int* entry_count, int* fence_count, uint64_t* entry_offset) {
+    if (memcmp(bytes, INDEX_MAGIC, 8) != 0 || get_u32(bytes + HEADER_VERSION) != INDEX_VERSION ||
+        get_u32(bytes + HEADER_DATA_RECORDS) != footer->record_count ||
+        get_u32(bytes + HEADER_DATA_CHECKSUM) != footer->checksum) {
+        return 0;
+    }
+    uint32_t count = get_u32(bytes + HEADER_ENTRY_COUNT);
+    if (count > footer->record_count) {
+        return 0;                                   /* ڼ¼ */
+    }
+    *entry_count = (int)count;
+    *fence_count = fence_count_for(*entry_count);
+    *entry_offset = entry_offset_for(*fence_count);
+    return get_u32(bytes + HEADER_FENCE_COUNT) == (uint32_t)*fence_count &&
+           get_u32(bytes + HEADER_ENTRY_OFFSET) == (uint32_t)*entry_offset &&
+           *entry_offset + (uint64_t)count * INDEX_ENTRY_SIZE <= file_size;
+}
+
+/*
+ * id_file_index_patch
+ * ܣļ͵ظд󣬰ѸĶĲλͬļ
+ * data_file - ļ, old_footer/new_footer - дǰļβ,
+ *       changes - ĶĲλ, change_count - Ķ
+ * ֵ1ʾɹ0ʾԭڡѹڻдʧ
+ * ˼·ԭȥĶλϵľдд
+ *           ֻݼ¼ķ֮һСԶСдļ
+ */
+int id_file_index_patch(const char* data_file, const PlayerFileFooter* old_footer,
+                        const PlayerFileFooter* new_footer,
+                        const IdFileIndexChange* changes, int change_count) {
+    char path[270];
+    index_path(data_file, path, sizeof(path));
+    FILE* file_ptr = fopen(path, "rb");
+    if (file_ptr == NULL) {
+        return 0;
+    }
+    
+    /* һ˶ԭӦдǰļ */
+    unsigned char header[INDEX_HEADER_SIZE];
+    __int64 file_size = -1;
+    if (_fseeki64(file_ptr, 0, SEEK_END) == 0) {
+        file_size = _ftelli64(file_ptr);
+    }
+    int entry_count = 0, fence_count = 0;
+    uint64_t entry_offset = 0;
+    int ok = file_size >= INDEX_HEADER_SIZE && _fseeki64(file_ptr, 0, SEEK_SET) == 0 &&
+             fread(header, sizeof(header), 1, file_ptr) == 1 &&
+             read_header(header, (uint64_t)file_size, old_footer, &entry_count, &fence_count, &entry_offset);
+    
+    /* ڶǸĶĲλдλڸдǰ */
+    int slot_count = (int)(new_footer->record_count > old_footer->record_count
+                           ? new_footer->record_count : old_footer->record_count);
+    unsigned char* changed = ok ? (unsigned char*)calloc((size_t)slot_count + 1, 1) : NULL;
+    IndexEntry* entries = ok ? (IndexEntry*)malloc((size_t)(entry_count + change_count + 1) * sizeof(IndexEntry)) : NULL;
+    unsigned char* block = ok ? (unsigned char*)malloc(INDEX_WRITE_BLOCK) : NULL;
+    ok = ok && changed != NULL && entries != NULL && block != NULL;
+    for (int c = 0; ok && c < change_count; c++) {
+        ok = changes[c].slot >= 0 && changes[c].slot < slot_count;
+        if (ok) changed[changes[c].slot] = 1;
+    }
+    
+    /* ԭĶĲλ */
+    int used = 0;
+    ok = ok && _fseeki64(file_ptr, (__int64)entry_offset, SEEK_SET) == 0;
+    for (int first = 0; ok && first < entry_count; first += INDEX_WRITE_BLOCK / INDEX_ENTRY_SIZE) {
+        int n = entry_count - first;
+        if (n > INDEX_WRITE_BLOCK / INDEX_ENTRY_SIZE) n = INDEX_WRITE_BLOCK / INDEX_ENTRY_SIZE;
+        ok = fread(block, INDEX_ENTRY_SIZE, (size_t)n, file_ptr) == (size_t)n;
+        for (int i = 0; ok && i < n; i++) {
+            uint32_t slot = get_u32(block + (size_t)i * INDEX_ENTRY_SIZE + 8);
+            ok = slot < (uint32_t)slot_count;
+            if (ok && !changed[slot]) {
+                entries[used].key = get_u64(block + (size_t)i * INDEX_ENTRY_SIZE);
+                entries[used].slot = (int)slot;
+                used++;
+            }
+        }
+    }
+    fclose(file_ptr);
+    
+    /* Ĳдд */
+    for (int c = 0; ok && c < change_count; c++) {
+        if (changes[c].key != INVALID_PLAYER_KEY) {
+            entries[used].key = changes[c].key;
+            entries[used].slot = changes[c].slot;
+            used++;
+        }
+    }
+    ok = ok && write_index(data_file, entries, used, new_footer);
+    free(changed);
+    free(entries);
+    free(block);
+    return ok;
+}
+
+/*
+ * id_file_index_open
+ * ܣӳļԵļ
+ * data_file - ļ, footer - ǰļļβ
+ * ֵ1ʾã0ʾڡѹڻ
+ * ˵ֻȡļͷҳڲʱŰ
+ */
+int id_file_index_open(const char* data_file, const PlayerFileFooter* footer) {
+    id_file_index_close();
+    char path[270];
+    index_path(data_file, path, sizeof(path));
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return 0;                                   /* ûļ */
+    }
+    
+    LARGE_INTEGER file_size;
+    HANDLE section = NULL;
+    const unsigned char* view = NULL;
+    if (GetFileSizeEx(file, &file_size) && file_size.QuadPart >= INDEX_HEADER_SIZE) {
+        section = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+    if (section != NULL) {
+        view = (const unsigned char*)MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0);
+    }
+    int entry_count = 0, fence_count = 0;
+    uint64_t entry_offset = 0;
+    if (view == NULL ||
+        !read_header(view, (uint64_t)file_size.QuadPart, footer, &entry_count, &fence_count, &entry_offset)) {
+        if (view != NULL) UnmapViewOfFile(view);
+        if (section != NULL) CloseHandle(section);
+        CloseHandle(file);
+        return 0;                                   /* 𻵻ļ */
+    }
+    
+    index_file = file;
+    index_section = section;
+    index_view = view;
+    index_fences = view + INDEX_HEADER_SIZE;
+    index_entries = view + entry_offset;
+    index_entry_count = entry_count;
+    index_fence_count = fence_count;
+    return 1;
+}
+
+/*
+ * id_file_index_find
+ * ܣӳļвѧ
+ * key - ѧ, slot - ¼λѧŲʱΪ-1
+ * ֵ1ʾѲң0ʾδ
+ * 㷨ڷҳһkeyҳڸҳж֣
+ *       ҳСβҺפڴ棬ÿβֻͨһҳ
+ */
+int id_file_index_find(uint64_t key, int* slot) {
+    if (index_view == NULL) {
+        return 0;
+    }
+    *slot = -1;
+    int low = 0, high = index_fence_count;          /* һҳkeyҳ */
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (get_u64(index_fences + (size_t)mid * sizeof(uint64_t)) <= key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low == 0) {
+        return 1;                                   /* СļС */
+    }
+    low = (low - 1) * INDEX_ENTRIES_PER_PAGE;       /* ڸҳڶ */
+    high = low + INDEX_ENTRIES_PER_PAGE;
+    if (high > index_entry_count) high = index_entry_count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        const unsigned char* entry = index_entries + (size_t)mid * INDEX_ENTRY_SIZE;
+        uint64_t mid_key = get_u64(entry);
+        if (mid_key == key) {
+            *slot = (int)get_u32(entry + 8);
+            return 1;
+        }
+        if (mid_key < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return 1;
+}
+
+/*
+ * id_file_index_close
+ * ܣͷӳļ
+ * 
+ */
+void id_file_index_close(void) {
+    if (index_view == NULL) {
+        return;
+    }
+    UnmapViewOfFile(index_view);
+    CloseHandle(index_section);
+    CloseHandle(index_file);
+    index_view = NULL;
+    index_section = NULL;
+    index_file = INVALID_HANDLE_VALUE;
+    index_fences = NULL;
+    index_entries = NULL;
+    index_entry_count = 0;
+    index_fence_count = 0;
+}
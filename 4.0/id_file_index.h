@@ -0,0 +1,86 @@
+#ifndef ID_FILE_INDEX_H
+#define ID_FILE_INDEX_H
+
+#include <stdint.h>
+#include "data_struct.h"
+#include "file_format.h"
+
+/*
+ * ѧļģ飨players.dat.idx
+ * ļʱԱдһݰѧ ѧ -> ¼λ ձ
+ * ֻӳģʽmap_player_data_fileѧŲʱֱӳļжֲң
+ * ɨȫ¼ڴϣһԱֻһҳ
+ *
+ * ļ = [ļͷ 32ֽ] [ҳ fence_count*8ֽ] [4096ֽڱ߽] [ entry_count*16ֽ]
+ *   ļͷħ"PLAYRIDX"汾šҳʼƫơ
+ *           Ӧļļ¼λУͣļβݣ
+ *   ѧ(8ֽ) + ¼λ(4ֽ) + (4ֽ)ÿҳǡ256
+ *   ҳÿҳһļжȷҳڸҳڶ
+ * С洢ļβļͷмµĲһʱļڴ˺󱻸д
+ * дʧܻ;Ϊڲʹã˻ڴ
+ */
+
+#define ID_FILE_INDEX_SUFFIX ".idx"          /* ļ = ļӸú׺ */
+#define ID_FILE_INDEX_PAGE_SIZE 4096         /* ҳֽ */
+
+/*
+ * һλĶ͵ظдļʱͬ
+ */
+typedef struct IdFileIndexChange {
+    int slot;                       /* ļеĲλ± */
+    uint64_t key;                   /* дòλ¼ѧղΪINVALID_PLAYER_KEY */
+} IdFileIndexChange;
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * id_file_index_write
+ * ܣдļļ
+ * data_file - ļ, records - ļλ˳еļ¼, count - ¼,
+ *       footer - ļļβ
+ * ֵ1ʾɹ0ʾʧܣԭļֲ䣬ļٱʹã
+ * ˵ֻȡݣں̨߳еãѧŷǷļ¼
+ */
+int id_file_index_write(const char* data_file, const Player* records, int count,
+                        const PlayerFileFooter* footer);
+
+/*
+ * id_file_index_patch
+ * ܣļ͵ظд󣬰ѸĶĲλͬļ
+ * data_file - ļ, old_footer/new_footer - дǰļβ,
+ *       changes - ĶĲλ, change_count - Ķ
+ * ֵ1ʾɹ0ʾԭڡѹڻдʧܣ˺ٱʹã´дʱؽ
+ * ˵ֻȡļں̨߳е
+ */
+int id_file_index_patch(const char* data_file, const PlayerFileFooter* old_footer,
+                        const PlayerFileFooter* new_footer,
+                        const IdFileIndexChange* changes, int change_count);
+
+/*
+ * id_file_index_open
+ * ܣӳļԵļ
+ * data_file - ļ, footer - ǰļļβ
+ * ֵ1ʾã0ʾڡѹڻ
+ * ˵ӳģʽʱãѴ򿪵ȱر
+ */
+int id_file_index_open(const char* data_file, const PlayerFileFooter* footer);
+
+/*
+ * id_file_index_find
+ * ܣӳļвѧ
+ * key - ѧ, slot - ¼λѧŲʱΪ-1
+ * ֵ1ʾѲң*slotУ0ʾδ
+ */
+int id_file_index_find(uint64_t key, int* slot);
+
+/*
+ * id_file_index_close
+ * ܣͷӳļ
+ * 
+ */
+void id_file_index_close(void);
+
+#endif /* ID_FILE_INDEX_H */
@@ -0,0 +1,197 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "data_struct.h"
+#include "player_store.h"
+#include "id_index.h"
+
+/*
+ * ϣͰṹֱӱѧ̽ʱֻһȽ
+ */
+typedef struct IdIndexBucket {
+    uint64_t key;               /* ѧ */
+    PlayerHandle handle;        /* ԱINVALID_PLAYER_HANDLEʾͰ */
+} IdIndexBucket;
+
+static IdIndexBucket* buckets = NULL;    /* Ͱ飬Ϊ2 */
+static int bucket_count = 0;             /* Ͱ */
+static int used_count = 0;               /* ռͰ */
+
+#define ID_INDEX_MIN_BUCKETS 64          /* СͰ */
+
+/*
+ * hash_key
+ * ܣѧĹϣֵ˷ɢУߵλϣ
+ * ˵ѧŵĵλ߶أԻƽλʹֲ
+ */
+static unsigned int hash_key(uint64_t key) {
+    uint64_t mixed = key * 0x9E3779B97F4A7C15ull;
+    return (unsigned int)(mixed ^ (mixed >> 32));
+}
+
+/*
+ * place_bucket
+ * ܣͰеһλ÷֤ظпλ
+ */
+static void place_bucket(IdIndexBucket* table, int mask, IdIndexBucket bucket) {
+    int pos = (int)(hash_key(bucket.key) & (unsigned int)mask);
+    while (table[pos].handle != INVALID_PLAYER_HANDLE) {
+        pos = (pos + 1) & mask;                 /* ̽һͰ */
+    }
+    table[pos] = bucket;
+}
+
+/*
+ * resize_table
+ * ܣͰ·䲢ǨȫͰ
+ */
+static int resize_table(int new_bucket_count) {
+    IdIndexBucket* table = (IdIndexBucket*)malloc((size_t)new_bucket_count * sizeof(IdIndexBucket));
+    if (table == NULL) {
+        return 0;                               /* ڴ治㣬ԭֲ */
+    }
+    for (int i = 0; i < new_bucket_count; i++) {
+        table[i].handle = INVALID_PLAYER_HANDLE;
+    }
+    for (int i = 0; i < bucket_count; i++) {    /* ǨռõͰ */
+        if (buckets[i].handle != INVALID_PLAYER_HANDLE) {
+            place_bucket(table, new_bucket_count - 1, buckets[i]);
+        }
+    }
+    free(buckets);
+    buckets = table;
+    bucket_count = new_bucket_count;
+    return 1;
+}
+
+/*
+ * id_index_reserve
+ * ܣԤexpected_countѧŵͰռ䣬ʱ
+ * expected_count - ԤƵѧ
+ * ֵ1ʾɹ0ʾڴ治
+ */
+int id_index_reserve(int expected_count) {
+    int needed = ID_INDEX_MIN_BUCKETS;
+    while ((long long)expected_count * 10 > (long long)needed * 7) {
+        needed *= 2;                            /* ֤Ӳ70% */
+    }
+    if (needed <= bucket_count) {
+        return 1;                               /* Ͱ㹻 */
+    }
+    return resize_table(needed);
+}
+
+/*
+ * find_bucket
+ * ܣѧżڵͰ±
+ * ֵҵͰ±꣬δҵ-1
+ */
+static int find_bucket(uint64_t key) {
+    if (bucket_count == 0) return -1;           /* ձ */
+    int mask = bucket_count - 1;
+    int pos = (int)(hash_key(key) & (unsigned int)mask);
+    while (buckets[pos].handle != INVALID_PLAYER_HANDLE) {   /* Ͱ */
+        if (buckets[pos].key == key) {          /* Ƚ */
+            return pos;
+        }
+        pos = (pos + 1) & mask;
+    }
+    return -1;
+}
+
+/*
+ * id_index_insert
+ * ܣǼѧżĶӦϵ
+ * key - ѧ, handle - Ա
+ * ֵ1ʾɹ0ʾѧѴڡǷڴ治
+ */
+int id_index_insert(uint64_t key, PlayerHandle handle) {
+    if (key == INVALID_PLAYER_KEY) {
+        return 0;                               /* ǷѧŲ */
+    }
+    if (find_bucket(key) >= 0) {
+        return 0;                               /* ѧѴ */
+    }
+    if (!id_index_reserve(used_count + 1)) {
+        return 0;                               /* ʧ */
+    }
+    IdIndexBucket bucket;
+    bucket.key = key;
+    bucket.handle = handle;
+    place_bucket(buckets, bucket_count - 1, bucket);
+    used_count++;
+    return 1;
+}
+
+/*
+ * id_index_find
+ * ܣѧżԱO(1)
+ * key - ѧ
+ * ֵҵؾδҵINVALID_PLAYER_HANDLE
+ */
+PlayerHandle id_index_find(uint64_t key) {
+    int pos = find_bucket(key);
+    return pos >= 0 ? buckets[pos].handle : INVALID_PLAYER_HANDLE;
+}
+
+/*
+ * id_index_remove
+ * ܣƳѧż
+ * key - ѧ
+ * ֵ1ʾƳɹ0ʾѧŲ
+ * 㷨ƻѺ̽ϵͰǰλ֤Ҳ
+ */
+int id_index_remove(uint64_t key) {
+    int hole = find_bucket(key);
+    if (hole < 0) {
+        return 0;                               /* ѧŲ */
+    }
+    int mask = bucket_count - 1;
+    int pos = (hole + 1) & mask;
+    while (buckets[pos].handle != INVALID_PLAYER_HANDLE) {
+        int home = (int)(hash_key(buckets[pos].key) & (unsigned int)mask);   /* Ͱλ */
+        /* λò(hole, pos]ʱͰǰƵλ */
+        if (((pos - home) & mask) >= ((pos - hole) & mask)) {
+            buckets[hole] = buckets[pos];
+            hole = pos;
+        }
+        pos = (pos + 1) & mask;
+    }
+    buckets[hole].handle = INVALID_PLAYER_HANDLE;
+    used_count--;
+    return 1;
+}
+
+/*
+ * id_index_rebuild
+ * ܣǰ洢ؽļغã
+ * 
+ * ֵ1ʾɹ0ʾڴ治㣻ظѧֻһǷ뱻ųļ¼
+ */
+int id_index_rebuild(void) {
+    for (int i = 0; i < bucket_count; i++) {    /* ȫͰ */
+        buckets[i].handle = INVALID_PLAYER_HANDLE;
+    }
+    used_count = 0;
+    if (!id_index_reserve(player_store.count)) {
+        return 0;                               /* һԤؽ̲ */
+    }
+    for (int i = 0; i < player_store.count; i++) {
+        if (!player_store_excluded(i)) {
+            id_index_insert(player_store.records[i].id_key, player_store_handle_at(i));
+        }
+    }
+    return 1;
+}
+
+/*
+ * id_index_release
+ * ܣͷռõȫڴ
+ * 
+ */
+void id_index_release(void) {
+    free(buckets);
+    buckets = NULL;
+    bucket_count = 0;
+    used_count = 0;
+}
@@ -0,0 +1,66 @@
+#ifndef ID_INDEX_H
+#define ID_INDEX_H
+
+#include "player_store.h"
+
+/*
+ * ѧŹϣģ
+ * Ŷַ̽⣩ϣѧ -> Ա
+ * Ͱֱӱֻ̽ȽϣԱ¼
+ * ɾúƻвĹʼղ70%
+ * ȶ洢swap-removeƶ¼ʱ
+ */
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * id_index_reserve
+ * ܣԤexpected_countѧŵͰռ䣬ʱ
+ * expected_count - ԤƵѧ
+ * ֵ1ʾɹ0ʾڴ治
+ */
+int id_index_reserve(int expected_count);
+
+/*
+ * id_index_insert
+ * ܣǼѧżĶӦϵ
+ * key - ѧ, handle - Ա
+ * ֵ1ʾɹ0ʾѧѴڡǷڴ治
+ */
+int id_index_insert(uint64_t key, PlayerHandle handle);
+
+/*
+ * id_index_find
+ * ܣѧżԱO(1)
+ * key - ѧ
+ * ֵҵؾδҵINVALID_PLAYER_HANDLE
+ */
+PlayerHandle id_index_find(uint64_t key);
+
+/*
+ * id_index_remove
+ * ܣƳѧż
+ * key - ѧ
+ * ֵ1ʾƳɹ0ʾѧŲ
+ */
+int id_index_remove(uint64_t key);
+
+/*
+ * id_index_rebuild
+ * ܣǰ洢ؽļغã
+ * 
+ * ֵ1ʾɹ0ʾڴ治㣻ظѧֻһǷ
+ */
+int id_index_rebuild(void);
+
+/*
+ * id_index_release
+ * ܣͷռõȫڴ
+ * 
+ */
+void id_index_release(void);
+
+#endif /* ID_INDEX_H */
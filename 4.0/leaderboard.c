@@ -0,0 +1,499 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "data_struct.h"
+#include "player_store.h"
+#include "team_pool.h"
+#include "stats_calculator.h"
+#include "leaderboard.h"
+
+#define BUCKET_COUNT (LEADERBOARD_SCORE_LIMIT + 2)   /* ˵Ͱ */
+#define SCOPE_COUNT 3                                /* ÿԱڵаӡλ */
+#define FENWICK_TOP_STEP 2048                        /* BUCKET_COUNT2ݣ״ҵʼ */
+
+/*
+ * ͰЧʷͬԱ˳
+ */
+typedef struct ScoreBucket {
+    PlayerHandle* handles;      /* Ͱھ */
+    int count;                  /* Ͱ */
+    int capacity;               /*  */
+} ScoreBucket;
+
+/*
+ * һаlowest/highestΪ͡ߵķǿͰаΪʱlowest > highest
+ * treeΪͰ״飨±1ʼiӦͰi-1O(log Ͱ)ٷλ
+ */
+typedef struct ScoreSet {
+    ScoreBucket buckets[BUCKET_COUNT];
+    int tree[BUCKET_COUNT + 1];
+    int count;                  /* ϰ */
+    int lowest, highest;
+} ScoreSet;
+
+static ScoreSet league_board;                   /* ȫа */
+static ScoreSet position_boards[POSITION_COUNT];   /* λа */
+static ScoreSet** team_boards = NULL;           /* аԱʱ */
+static int team_capacity = 0;                   /* а */
+static int* handle_position[SCOPE_COUNT] = {NULL, NULL, NULL};   /*  -> Ͱе± */
+static int handle_capacity = 0;                 /* handle_position */
+static PlayerHandle* page_scratch = NULL;       /* ȡʱõʱ */
+static int scratch_capacity = 0;
+static int initialized = 0;                     /* аlowest/highestǷΪ */
+
+/*
+ * bucket_of
+ * ܣȡЧʷڵͰ0BUCKET_COUNT-1ΪͰ
+ */
+static int bucket_of(int64_t score) {
+    if (score < 0) return 0;
+    if (score >= LEADERBOARD_SCORE_LIMIT) return BUCKET_COUNT - 1;
+    return (int)score + 1;
+}
+
+/*
+ * reset_board
+ * ܣһаΪգͷͰ
+ */
+static void reset_board(ScoreSet* board) {
+    board->count = 0;
+    board->lowest = BUCKET_COUNT;
+    board->highest = -1;
+}
+
+/*
+ * ensure_initialized
+ * ܣ״ʹʱѾ̬аΪ
+ */
+static void ensure_initialized(void) {
+    if (initialized) return;
+    reset_board(&league_board);
+    for (int p = 0; p < POSITION_COUNT; p++) {
+        reset_board(&position_boards[p]);
+    }
+    initialized = 1;
+}
+
+/*
+ * reserve_handles
+ * ܣ֤ӳ±handle
+ */
+static int reserve_handles(PlayerHandle handle) {
+    if (handle < handle_capacity) return 1;
+    int new_capacity = handle_capacity > 0 ? handle_capacity : 64;
+    while (new_capacity <= handle) {
+        new_capacity *= 2;
+    }
+    for (int s = 0; s < SCOPE_COUNT; s++) {
+        int* grown = (int*)realloc(handle_position[s], (size_t)new_capacity * sizeof(int));
+        if (grown == NULL) return 0;
+        handle_position[s] = grown;
+    }
+    handle_capacity = new_capacity;
+    return 1;
+}
+
+/*
+ * team_board
+ * ܣȡаcreateΪ1ʱ
+ * ֵаָ룬ڣڴ治㣩ʱNULL
+ */
+static ScoreSet* team_board(int team_id, int create) {
+    if (team_id < 0) return NULL;
+    if (team_id >= team_capacity) {
+        if (!create) return NULL;
+        int new_capacity = team_capacity > 0 ? team_capacity : 16;
+        while (new_capacity <= team_id) {
+            new_capacity *= 2;
+        }
+        ScoreSet** grown = (ScoreSet**)realloc(team_boards, (size_t)new_capacity * sizeof(ScoreSet*));
+        if (grown == NULL) return NULL;
+        memset(&grown[team_capacity], 0, (size_t)(new_capacity - team_capacity) * sizeof(ScoreSet*));
+        team_boards = grown;
+        team_capacity = new_capacity;
+    }
+    if (team_boards[team_id] == NULL && create) {
+        ScoreSet* board = (ScoreSet*)calloc(1, sizeof(ScoreSet));
+        if (board == NULL) return NULL;
+        reset_board(board);
+        team_boards[team_id] = board;
+    }
+    return team_boards[team_id];
+}
+
+/*
+ * fenwick_add / fenwick_prefix
+ * ܣ״飺ͰbdeltaͰ0Ͱb֮ͣbΪ-1ʱΪ0
+ */
+static void fenwick_add(ScoreSet* board, int b, int delta) {
+    for (int i = b + 1; i <= BUCKET_COUNT; i += i & -i) {
+        board->tree[i] += delta;
+    }
+}
+
+static int fenwick_prefix(const ScoreSet* board, int b) {
+    int sum = 0;
+    for (int i = b + 1; i > 0; i -= i & -i) {
+        sum += board->tree[i];
+    }
+    return sum;
+}
+
+/*
+ * fenwick_select
+ * ܣҳЧʷִӵ͵ߵkˣk1ʼڵͰ
+ * ֵͰ±ꣻ*beforeΪͰ֮ǰ͵Ͱ
+ * 㷨״ϰ2ݲ½O(log Ͱ)
+ */
+static int fenwick_select(const ScoreSet* board, int k, int* before) {
+    int position = 0;                           /* ȷ֮Сkǰ׺ */
+    int sum = 0;
+    for (int step = FENWICK_TOP_STEP; step > 0; step >>= 1) {
+        int next = position + step;
+        if (next <= BUCKET_COUNT && sum + board->tree[next] < k) {
+            position = next;
+            sum += board->tree[next];
+        }
+    }
+    *before = sum;
+    return position;                            /* ״position+1Ͱposition */
+}
+
+/*
+ * board_insert
+ * ܣѾаЧʷڵͰ
+ * positions - ÷Χľӳ
+ * ֵ1ʾɹ0ʾڴ治
+ */
+static int board_insert(ScoreSet* board, int* positions, int64_t score, PlayerHandle handle) {
+    int b = bucket_of(score);
+    ScoreBucket* bucket = &board->buckets[b];
+    if (bucket->count == bucket->capacity) {    /* Ͱ */
+        int new_capacity = bucket->capacity > 0 ? bucket->capacity * 2 : 8;
+        PlayerHandle* grown = (PlayerHandle*)realloc(bucket->handles,
+                                                     (size_t)new_capacity * sizeof(PlayerHandle));
+        if (grown == NULL) return 0;
+        bucket->handles = grown;
+        bucket->capacity = new_capacity;
+    }
+    positions[handle] = bucket->count;
+    bucket->handles[bucket->count++] = handle;
+    board->count++;
+    fenwick_add(board, b, 1);
+    if (b < board->lowest) board->lowest = b;
+    if (b > board->highest) board->highest = b;
+    return 1;
+}
+
+/*
+ * board_remove
+ * ܣѾЧʷڵͰƳͰĩβľλ
+ * 㷨O(1)ƳͣߣǿͰһʱѰһǿͰ
+ */
+static void board_remove(ScoreSet* board, int* positions, int64_t score, PlayerHandle handle) {
+    int b = bucket_of(score);
+    ScoreBucket* bucket = &board->buckets[b];
+    int position = positions[handle];
+    PlayerHandle moved = bucket->handles[--bucket->count];
+    bucket->handles[position] = moved;
+    positions[moved] = position;
+    board->count--;
+    fenwick_add(board, b, -1);
+    if (bucket->count > 0) {
+        return;
+    }
+    while (board->lowest <= board->highest && board->buckets[board->lowest].count == 0) {
+        board->lowest++;
+    }
+    while (board->highest >= board->lowest && board->buckets[board->highest].count == 0) {
+        board->highest--;
+    }
+    if (board->lowest > board->highest) {
+        reset_board(board);                     /* аѿ */
+    }
+}
+
+/*
+ * leaderboard_insert
+ * ܣһԱǼǵȫλõа
+ * player - ¼, handle - ¼
+ * ֵ1ʾɹ0ʾڴ治ӱŷǷа񲻱䣩
+ */
+int leaderboard_insert(const Player* player, PlayerHandle handle) {
+    ensure_initialized();
+    if (player->team_id >= team_pool_count()) return 0;   /* ŷǷ */
+    if (!reserve_handles(handle)) return 0;
+    ScoreSet* team = team_board(player->team_id, 1);
+    if (team == NULL) return 0;
+
+    int64_t score = calculate_efficiency_score(player);
+    if (!board_insert(&league_board, handle_position[LEADERBOARD_LEAGUE], score, handle)) return 0;
+    if (!board_insert(team, handle_position[LEADERBOARD_TEAM], score, handle)) {
+        board_remove(&league_board, handle_position[LEADERBOARD_LEAGUE], score, handle);
+        return 0;
+    }
+    if (player->position < POSITION_COUNT &&
+        !board_insert(&position_boards[player->position], handle_position[LEADERBOARD_POSITION],
+                      score, handle)) {
+        board_remove(&league_board, handle_position[LEADERBOARD_LEAGUE], score, handle);
+        board_remove(team, handle_position[LEADERBOARD_TEAM], score, handle);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * leaderboard_remove
+ * ܣһԱӸаע
+ * player - ¼Ǽʱͬ, handle - ¼
+ */
+void leaderboard_remove(const Player* player, PlayerHandle handle) {
+    int64_t score = calculate_efficiency_score(player);
+    board_remove(&league_board, handle_position[LEADERBOARD_LEAGUE], score, handle);
+    board_remove(team_boards[player->team_id], handle_position[LEADERBOARD_TEAM], score, handle);
+    if (player->position < POSITION_COUNT) {
+        board_remove(&position_boards[player->position], handle_position[LEADERBOARD_POSITION],
+                     score, handle);
+    }
+}
+
+/*
+ * find_board
+ * ܣΧȡа
+ * ֵаָ룬ʱNULL
+ */
+static const ScoreSet* find_board(LeaderboardScope scope, int key) {
+    ensure_initialized();
+    switch (scope) {
+        case LEADERBOARD_LEAGUE:
+            return &league_board;
+        case LEADERBOARD_TEAM:
+            return team_board(key, 0);
+        case LEADERBOARD_POSITION:
+            return key >= 0 && key < POSITION_COUNT ? &position_boards[key] : NULL;
+        default:
+            return NULL;
+    }
+}
+
+/*
+ * leaderboard_size
+ * ܣȡаϵ
+ * scope - Χ, key - ӱŻλ
+ * ֵΧʱΪ0
+ */
+int leaderboard_size(LeaderboardScope scope, int key) {
+    const ScoreSet* board = find_board(scope, key);
+    return board != NULL ? board->count : 0;
+}
+
+/*
+ * compare_rank
+ * ܣqsortȽϺЧʷִӸߵͣͬʱѧŴС
+ * ˵ͨͰЧʷֶֻͬͰҪȽϷ
+ */
+static int compare_rank(const void* a, const void* b) {
+    const Player* left = player_store_get(*(const PlayerHandle*)a);
+    const Player* right = player_store_get(*(const PlayerHandle*)b);
+    int64_t left_score = calculate_efficiency_score(left);
+    int64_t right_score = calculate_efficiency_score(right);
+    if (left_score != right_score) {
+        return left_score > right_score ? -1 : 1;
+    }
+    if (left->id_key != right->id_key) {
+        return left->id_key < right->id_key ? -1 : 1;
+    }
+    return 0;
+}
+
+/*
+ * leaderboard_page
+ * ܣ˳ȡаϴӵfirst_rankλԱ
+ * scope - Χ, key - ӱŻλ,
+ *        first_rank - ʼλΣ1ʼ˳, max_count - ȡ, handles - 
+ * ֵʵʶȡλγڴ治ʱΪ0
+ * 㷨߷ֵͰ£Ͱʼλ֮ǰͰֻͰ
+ *       λصͰ˳ȡ貿
+ */
+int leaderboard_page(LeaderboardScope scope, int key, int first_rank, int max_count,
+                     PlayerHandle* handles) {
+    const ScoreSet* board = find_board(scope, key);
+    if (board == NULL || first_rank < 1 || max_count <= 0) {
+        return 0;
+    }
+    int skip = first_rank - 1;                  /*  */
+    int written = 0;
+    for (int b = board->highest; b >= board->lowest && written < max_count; b--) {
+        const ScoreBucket* bucket = &board->buckets[b];
+        if (skip >= bucket->count) {            /* Ͱʼ֮ǰͰ */
+            skip -= bucket->count;
+            continue;
+        }
+        if (bucket->count > scratch_capacity) {
+            PlayerHandle* grown = (PlayerHandle*)realloc(page_scratch,
+                                                         (size_t)bucket->count * sizeof(PlayerHandle));
+            if (grown == NULL) return 0;
+            page_scratch = grown;
+            scratch_capacity = bucket->count;
+        }
+        memcpy(page_scratch, bucket->handles, (size_t)bucket->count * sizeof(PlayerHandle));
+        qsort(page_scratch, (size_t)bucket->count, sizeof(PlayerHandle), compare_rank);
+        int take = bucket->count - skip;
+        if (take > max_count - written) take = max_count - written;
+        memcpy(&handles[written], &page_scratch[skip], (size_t)take * sizeof(PlayerHandle));
+        written += take;
+        skip = 0;
+    }
+    return written;
+}
+
+/*
+ * on_board
+ * ܣжϾǷǼڸ÷Χа
+ */
+static int on_board(const ScoreSet* board, LeaderboardScope scope, PlayerHandle handle, int b) {
+    if (handle < 0 || handle >= handle_capacity) return 0;
+    int position = handle_position[scope][handle];
+    const ScoreBucket* bucket = &board->buckets[b];
+    return position >= 0 && position < bucket->count && bucket->handles[position] == handle;
+}
+
+/*
+ * count_higher_in_bucket
+ * ܣͰЧʷָscoreֻͰڵķͬ
+ */
+static int count_higher_in_bucket(const ScoreBucket* bucket, int64_t score) {
+    int higher = 0;
+    for (int i = 0; i < bucket->count; i++) {
+        if (calculate_efficiency_score(player_store_get(bucket->handles[i])) > score) {
+            higher++;
+        }
+    }
+    return higher;
+}
+
+/*
+ * leaderboard_rank
+ * ܣԱаϵٷλ
+ * scope - Χ, key - ӱŻλ, handle - Ա,
+ *        percentile - ٷλЧʷֲڸԱռȣ0-100ΪNULL
+ * ֵΣЧʷָߵ+1ͬͬԱڸаʱ0
+ * 㷨״ǰ׺ͣO(log Ͱ)ԱͰʱȽͰڷ
+ */
+int leaderboard_rank(LeaderboardScope scope, int key, PlayerHandle handle, double* percentile) {
+    const ScoreSet* board = find_board(scope, key);
+    const Player* player = player_store_get(handle);
+    if (board == NULL || player == NULL) return 0;
+    int64_t score = calculate_efficiency_score(player);
+    int b = bucket_of(score);
+    if (!on_board(board, scope, handle, b)) return 0;
+    
+    int higher_in_bucket = 0;                   /* ͬͰڷߵ */
+    if (b == 0 || b == BUCKET_COUNT - 1) {
+        higher_in_bucket = count_higher_in_bucket(&board->buckets[b], score);
+    }
+    int not_higher = fenwick_prefix(board, b) - higher_in_bucket;   /* ЧʷֲڸԱ */
+    if (percentile != NULL) {
+        *percentile = 100.0 * not_higher / board->count;
+    }
+    return board->count - not_higher + 1;
+}
+
+/*
+ * leaderboard_at_percentile
+ * ܣҳаϴڰٷλpԱ
+ * scope - Χ, key - ӱŻλ, percentile - ٷλ0-100ʱ߽紦
+ * ֵЧʷִӵ͵ߵceil(p%  )ˣٵ1ˣľаΪʱINVALID_PLAYER_HANDLE
+ * 㷨״½ҵڵͰO(log Ͱ)ͬʱΪһ
+ *       ͰʱѸͰȡ
+ */
+PlayerHandle leaderboard_at_percentile(LeaderboardScope scope, int key, double percentile) {
+    const ScoreSet* board = find_board(scope, key);
+    if (board == NULL || board->count == 0) return INVALID_PLAYER_HANDLE;
+    if (percentile < 0.0) percentile = 0.0;
+    if (percentile > 100.0) percentile = 100.0;
+    
+    double exact = percentile * board->count / 100.0;
+    int k = (int)exact;                         /* ӵ͵ߵλΣȡ */
+    if (k < exact) k++;
+    if (k < 1) k = 1;
+    if (k > board->count) k = board->count;
+    int before = 0;
+    int b = fenwick_select(board, k, &before);
+    const ScoreBucket* bucket = &board->buckets[b];
+    int within = k - before - 1;                /* Ͱڴӵ͵ߵ± */
+    if (b != 0 && b != BUCKET_COUNT - 1) {
+        return bucket->handles[within];         /* ͨͰЧʷֶͬ */
+    }
+    if (bucket->count > scratch_capacity) {
+        PlayerHandle* grown = (PlayerHandle*)realloc(page_scratch,
+                                                     (size_t)bucket->count * sizeof(PlayerHandle));
+        if (grown == NULL) return bucket->handles[within];   /* ڴ治㣬˻ͬͰһ */
+        page_scratch = grown;
+        scratch_capacity = bucket->count;
+    }
+    memcpy(page_scratch, bucket->handles, (size_t)bucket->count * sizeof(PlayerHandle));
+    qsort(page_scratch, (size_t)bucket->count, sizeof(PlayerHandle), compare_rank);   /* Ӹߵ */
+    return page_scratch[bucket->count - 1 - within];
+}
+
+/*
+ * leaderboard_rebuild
+ * ܣа񲢰ǰ洢ؽ
+ * ֵӱԽųplayer_store_excludedļ¼ڴ治㷵-1
+ */
+int leaderboard_rebuild(void) {
+    leaderboard_release();
+    int skipped = 0;                            /* ļ¼ */
+    for (int i = 0; i < player_store.count; i++) {
+        if (player_store_excluded(i) || player_store.records[i].team_id >= team_pool_count()) {
+            skipped++;                          /* ֻӳļϰ */
+            continue;
+        }
+        if (!leaderboard_insert(&player_store.records[i], player_store_handle_at(i))) {
+            return -1;
+        }
+    }
+    return skipped;
+}
+
+/*
+ * release_board
+ * ܣͷһаȫͰΪ
+ */
+static void release_board(ScoreSet* board) {
+    for (int b = 0; b < BUCKET_COUNT; b++) {
+        free(board->buckets[b].handles);
+    }
+    memset(board, 0, sizeof(ScoreSet));
+    reset_board(board);
+}
+
+/*
+ * leaderboard_release
+ * ܣͷаռõȫڴ
+ */
+void leaderboard_release(void) {
+    release_board(&league_board);
+    for (int p = 0; p < POSITION_COUNT; p++) {
+        release_board(&position_boards[p]);
+    }
+    for (int t = 0; t < team_capacity; t++) {
+        if (team_boards[t] != NULL) {
+            release_board(team_boards[t]);
+            free(team_boards[t]);
+        }
+    }
+    free(team_boards);
+    team_boards = NULL;
+    team_capacity = 0;
+    for (int s = 0; s < SCOPE_COUNT; s++) {
+        free(handle_position[s]);
+        handle_position[s] = NULL;
+    }
+    handle_capacity = 0;
+    free(page_scratch);
+    page_scratch = NULL;
+    scratch_capacity = 0;
+    initialized = 1;
+}
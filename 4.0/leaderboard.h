@@ -0,0 +1,107 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include "data_struct.h"
+#include "player_store.h"
+
+/*
+ * Чаģ
+ * Чʷ֣calculate_efficiency_scoreЧֵ10ΪȷԱͰ
+ * ȫÿ֧ӡÿλøһаÿɾͬ£
+ * ȡһҳֻ߷ֵͰǰɨȫԱ
+ * ˳ΪЧʷִӸߵͣͬʱѧŴСΪЧʷָߵ+1
+ * ֵͬԱͬʾһҳʱͬ߰ѧУβУ
+ * ÿаиͰ״飬ԱΡٷλԼĳٷλϵԱ
+ * ֻO(log Ͱ)ԱƬɵ̽ʹá
+ * ͰΧΪ[0, LEADERBOARD_SCORE_LIMIT)Χķֻδ֤ľļ
+ * ˵ͰȡʱͰȽϡ
+ */
+
+#define LEADERBOARD_SCORE_LIMIT 2048     /* ЧʷַͰϽ磨Ϸ1155 */
+#define LEADERBOARD_PAGE_SIZE 50         /* аÿҳʾ */
+
+/*
+ * аΧ
+ */
+typedef enum LeaderboardScope {
+    LEADERBOARD_LEAGUE = 0,     /* ȫkeyʹ */
+    LEADERBOARD_TEAM = 1,       /* ֧ӣkeyΪӱ */
+    LEADERBOARD_POSITION = 2    /* λãkeyΪPlayerPositionǷλõԱϰ */
+} LeaderboardScope;
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * leaderboard_insert
+ * ܣһԱǼǵȫλõа
+ * player - ¼, handle - ¼
+ * ֵ1ʾɹ0ʾڴ治ӱŷǷа񲻱䣩
+ */
+int leaderboard_insert(const Player* player, PlayerHandle handle);
+
+/*
+ * leaderboard_remove
+ * ܣһԱӸаעڼ¼޸Ļɾ֮ǰã
+ * player - ¼Ǽʱͬ, handle - ¼
+ */
+void leaderboard_remove(const Player* player, PlayerHandle handle);
+
+/*
+ * leaderboard_size
+ * ܣȡаϵ
+ * scope - Χ, key - ӱŻλ
+ * ֵΧʱΪ0
+ */
+int leaderboard_size(LeaderboardScope scope, int key);
+
+/*
+ * leaderboard_page
+ * ܣ˳ȡаϴӵfirst_rankλԱ
+ * scope - Χ, key - ӱŻλ,
+ *        first_rank - ʼλΣ1ʼ˳ǲеΣ,
+ *        max_count - ȡ, handles - 
+ * ֵʵʶȡλγʱΪ0
+ * ʱ临ӶȣO(Ͱ + Ͱ)а޹
+ */
+int leaderboard_page(LeaderboardScope scope, int key, int first_rank, int max_count,
+                     PlayerHandle* handles);
+
+/*
+ * leaderboard_rank
+ * ܣԱаϵٷλ
+ * scope - Χ, key - ӱŻλ, handle - Ա,
+ *        percentile - ٷλЧʷֲڸԱռȣ0-100ΪNULL
+ * ֵΣЧʷָߵ+1ͬͬļͷԱڸаʱ0
+ * ʱ临ӶȣO(log Ͱ)
+ */
+int leaderboard_rank(LeaderboardScope scope, int key, PlayerHandle handle, double* percentile);
+
+/*
+ * leaderboard_at_percentile
+ * ܣҳаϴڰٷλpԱ
+ * scope - Χ, key - ӱŻλ, percentile - ٷλ0-100
+ * ֵЧʷִӵ͵ߵceil(p%  )ˣٵ1ˣľͬʱΪһ
+ *         аΪʱINVALID_PLAYER_HANDLE
+ * ʱ临ӶȣO(log Ͱ)
+ */
+PlayerHandle leaderboard_at_percentile(LeaderboardScope scope, int key, double percentile);
+
+/*
+ * leaderboard_rebuild
+ * ܣа񲢰ǰ洢ؽ
+ * 
+ * ֵӱԽųplayer_store_excludedļ¼ڴ治㷵-1
+ */
+int leaderboard_rebuild(void);
+
+/*
+ * leaderboard_release
+ * ܣͷаռõȫڴ
+ * 
+ */
+void leaderboard_release(void);
+
+#endif /* LEADERBOARD_H */
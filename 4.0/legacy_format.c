@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "data_struct.h"
+#include "file_ops.h"
+#include "legacy_format.h"
+
+#define LEGACY_ID_OFFSET 0               /* ѧֶƫƣ13ֽڣ */
+#define LEGACY_NAME_OFFSET 13            /* ֶƫƣ21ֽڣ */
+#define LEGACY_TEAM_OFFSET 34            /* ֶƫƣ31ֽڣ */
+#define LEGACY_POSITION_SIZE 11          /* λֶֽ */
+
+/*
+ * ֪ʷ֣жʱ÷ͬ˳ȣԽǰԽ
+ */
+static const LegacyLayout legacy_layouts[] = {
+    {"2.0-4.064λ", 96, 65, 76},
+    {"2.0-4.032λ", 92, 65, 76},
+    {"1.032λ", 84, -1, 68},
+    {"1.064λ", 88, -1, 68},
+    {"1.032λ䣩", 81, -1, 65},
+    {"1.064λ䣩", 85, -1, 65}
+};
+
+#define LEGACY_LAYOUT_COUNT ((int)(sizeof(legacy_layouts) / sizeof(legacy_layouts[0])))
+#define LEGACY_MAX_RECORD_SIZE 96        /* ļ¼ֽ */
+
+/*
+ * get_int
+ * ܣСȡ4ֽз
+ */
+static int get_int(const unsigned char* p) {
+    return (int)((uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24));
+}
+
+/*
+ * copy_text
+ * ܣƶıֶβ֤Խβ
+ */
+static void copy_text(char* text, const unsigned char* field, size_t size) {
+    memcpy(text, field, size);
+    text[size - 1] = '\0';
+}
+
+/*
+ * has_terminator
+ * ܣж϶ıֶǷнɰдıǴ
+ */
+static int has_terminator(const unsigned char* field, size_t size) {
+    return memchr(field, '\0', size) != NULL;
+}
+
+/*
+ * record_looks_valid
+ * ܣĳֲּһ¼ֶǷ
+ * ˵ɰ򼸺У룬˷Χŵúֲֻ֣ܿھܾ¼
+ */
+static int record_looks_valid(const LegacyLayout* layout, const unsigned char* bytes) {
+    if (bytes[LEGACY_ID_OFFSET] == '\0' ||
+        !has_terminator(bytes + LEGACY_ID_OFFSET, LEGACY_NAME_OFFSET - LEGACY_ID_OFFSET) ||
+        !has_terminator(bytes + LEGACY_NAME_OFFSET, LEGACY_TEAM_OFFSET - LEGACY_NAME_OFFSET) ||
+        !has_terminator(bytes + LEGACY_TEAM_OFFSET, LEGACY_TEAM_SIZE)) {
+        return 0;
+    }
+    if (layout->position_offset >= 0 &&
+        !has_terminator(bytes + layout->position_offset, LEGACY_POSITION_SIZE)) {
+        return 0;
+    }
+    int height = get_int(bytes + layout->height_offset);
+    int weight = get_int(bytes + layout->height_offset + 4);
+    int jersey = get_int(bytes + layout->height_offset + 8);
+    return height >= 0 && height <= 300 && weight >= 0 && weight <= 500 &&
+           jersey >= 0 && jersey <= 999;
+}
+
+/*
+ * score_layout
+ * ܣĳֲļоȳ¼ͳֶκ
+ * ֵȡʧܷ-1*samples
+ */
+static int score_layout(const LegacyLayout* layout, FILE* file_ptr, __int64 file_size, int* samples) {
+    __int64 record_count = file_size / layout->record_size;
+    *samples = record_count < LEGACY_SAMPLE_RECORDS ? (int)record_count : LEGACY_SAMPLE_RECORDS;
+    unsigned char bytes[LEGACY_MAX_RECORD_SIZE];
+    int score = 0;
+    for (int s = 0; s < *samples; s++) {
+        __int64 index = record_count * s / *samples;   /* ڳ֮ */
+        if (_fseeki64(file_ptr, index * layout->record_size, SEEK_SET) != 0 ||
+            fread(bytes, (size_t)layout->record_size, 1, file_ptr) != 1) {
+            return -1;
+        }
+        score += record_looks_valid(layout, bytes);
+    }
+    return score;
+}
+
+/*
+ * legacy_format_detect
+ * ܣжļͷļʹһʷ
+ * file_ptr - ļ, file_size - ļֽ, recognized - Ƿʶ
+ * ֵжϳĲ֣ļΪջ޷ʶ𷵻NULL
+ * ˼·ֲʱֶλô鵽ĺ¼Ҳλ٣
+ *           ȡĲ֣ͬʱļСǡģ̶ٰȣ
+ *           ĲһʱΪ޷ʶ
+ *           ǿնûκβƥ䣨Сļ¼̡ضļͷڵļʱͬ޷ʶ
+ *           ļȷ̴
+ */
+const LegacyLayout* legacy_format_detect(FILE* file_ptr, __int64 file_size, int* recognized) {
+    const LegacyLayout* best = NULL;
+    int best_score = 0, best_samples = 0, best_exact = 0;
+    *recognized = 1;
+    for (int i = 0; i < LEGACY_LAYOUT_COUNT; i++) {
+        const LegacyLayout* layout = &legacy_layouts[i];
+        if (file_size < layout->record_size) {
+            continue;                            /* һ¼û */
+        }
+        int samples;
+        int score = score_layout(layout, file_ptr, file_size, &samples);
+        int exact = file_size % layout->record_size == 0;
+        if (score * 2 < samples) {
+            continue;                            /* ¼ */
+        }
+        /* ȽϺıscore/samples˱ */
+        long long better = (long long)score * best_samples - (long long)best_score * samples;
+        if (best == NULL || better > 0 || (better == 0 && exact && !best_exact)) {
+            best = layout;
+            best_score = score;
+            best_samples = samples;
+            best_exact = exact;
+        }
+    }
+    if (best == NULL && file_size > 0) {         /* һ¼ķǿļͬ޷ʶ */
+        *recognized = 0;
+    }
+    return best;
+}
+
+/*
+ * legacy_format_decode
+ * ܣһʷ¼תΪڴ¼
+ * layout - ¼, bytes - ¼ֽ, player - ڴ¼, team - 
+ */
+void legacy_format_decode(const LegacyLayout* layout, const unsigned char* bytes,
+                          Player* player, char* team) {
+    memset(player, 0, sizeof(Player));
+    copy_text(player->id, bytes + LEGACY_ID_OFFSET, sizeof(player->id));
+    if (!pack_player_id(player->id, &player->id_key)) {
+        player->id_key = INVALID_PLAYER_KEY;     /* Ƿѧţ */
+    }
+    copy_text(player->name, bytes + LEGACY_NAME_OFFSET, sizeof(player->name));
+    copy_text(team, bytes + LEGACY_TEAM_OFFSET, LEGACY_TEAM_SIZE);
+    
+    player->position = POSITION_INVALID;         /* 1.0ûλֶ */
+    if (layout->position_offset >= 0) {
+        char position[LEGACY_POSITION_SIZE];
+        copy_text(position, bytes + layout->position_offset, sizeof(position));
+        player->position = (uint8_t)position_from_name(position);
+    }
+    player->height = get_int(bytes + layout->height_offset);
+    player->weight = get_int(bytes + layout->height_offset + 4);
+    player->jersey = get_int(bytes + layout->height_offset + 8);
+}
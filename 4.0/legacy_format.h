@@ -0,0 +1,58 @@
+#ifndef LEGACY_FORMAT_H
+#define LEGACY_FORMAT_H
+
+#include <stdio.h>
+#include "data_struct.h"
+
+/*
+ * players.datʽ1棬ļͷ
+ * ڸ汾ڵṹֱдļ¼汾λ뷽ʽͬ
+ *   1.0      ѧ(13) (21) (31) []    nextָ룬ûλֶ
+ *   2.04.0 ѧ(13) (21) (31) λ(11)    nextָ
+ * 32λָ4ֽڣ64λָ8ֽҽṹ尴8ֽڶ룻
+ * а1ֽڶ루䣩1.0Ϊx86С
+ * ļ¼õһֻ֣ļСܷ񱻼¼С
+ * Լ¼ֶǷѧŷǿաıԽβںΧжϡ
+ */
+
+#define LEGACY_TEAM_SIZE 31              /* ɰֶֽ */
+#define LEGACY_SAMPLE_RECORDS 64         /* жϲʱļ¼ */
+
+/*
+ * һʷ¼ֶ֣ڼ¼ڵƫ
+ * ѧšֶڸ汾λֱͬλ01334
+ */
+typedef struct LegacyLayout {
+    const char* name;               /* ˵ʾ */
+    int record_size;                /* ÿ¼ֽnextָ䣩 */
+    int position_offset;            /* λֶƫƣ-1ʾûλֶ */
+    int height_offset;              /* ƫƣء4ֽ */
+} LegacyLayout;
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * legacy_format_detect
+ * ܣжļͷļʹһʷ
+ * file_ptr - ļ, file_size - ļֽ
+ * ֵжϳĲ֣ļΪշNULL*recognizedΪ1
+ *         ǿն޷ʶ𣨰һ¼NULL*recognizedΪ0
+ * ˵ļλ֮ı䣬߶ȡ¼ǰ¶λ
+ */
+const LegacyLayout* legacy_format_detect(FILE* file_ptr, __int64 file_size, int* recognized);
+
+/*
+ * legacy_format_decode
+ * ܣһʷ¼תΪڴ¼
+ * layout - ¼, bytes - ¼ֽ, player - ڴ¼ӱδд,
+ *       team - ƣLEGACY_TEAM_SIZEֽ
+ * ˵ıֶα֤Խβûλֶεļ¼λΪPOSITION_INVALID
+ *       ѧŷǷʱΪINVALID_PLAYER_KEY
+ */
+void legacy_format_decode(const LegacyLayout* layout, const unsigned char* bytes,
+                          Player* player, char* team);
+
+#endif /* LEGACY_FORMAT_H */
@@ -10,23 +10,276 @@
 #include <stdlib.h>
 #include <string.h>
 #include "file_ops.h"
+#include "player_store.h"
+#include "team_pool.h"
 #include "player_manager.h"
 #include "stats_calculator.h"
 #include "display_manager.h"
+#include "leaderboard.h"
 #include "menu_system.h"
+#include "wal.h"
+#include "checkpoint.h"
+#include "autosave.h"
+
+#define NAME_SEARCH_LIMIT 50                     /* ҵгԱ */
+#define DATA_FILE_NAME "players.dat"             /* ļգ */
+#define JOURNAL_FILE_NAME "players.dat.wal"      /* Ԥд־ļwal.h */
+#define ROTATED_JOURNAL_FILE_NAME "players.dat.wal.1"   /* ̨еľ־checkpoint.h */
+#define DAMAGED_FILE_SUFFIX ".corrupt"           /* ȷϸ𻵵ļǰԭļ־ĺ׺ */
+
+static int data_damaged = 0;                     /* ļ𻵣δػ𻵵ļ¼дļûȷϸ */
+static int journal_skipped = 0;                  /* ļ޷ȡ־δط */
+
+/*
+ * load_data
+ * ܣģʽļطž־Ԥд־
+ * read_only - 1ʾֻģʽӳļ¼
+ * ֵغļ¼ļڷ0ļ𻵷-1
+ *         м¼Уʧʱ¼־طźļ¼𻵵ļ¼corrupt_record_report
+ * ˵ֻģʽ־ǿջļ޷ӳ䣨ɸʽļʱΪͨأ
+ *       ļ𻵻м¼ʱΪ״̬˺󱣴桢˳
+ *       дļյĻȱĴ洢ԭļoverwrite_damaged_data
+ *       ־ѧдɾļ޹أּ¼ʱճطţ򿪹׷ӣ
+ *       𻵵ļ¼˺޸ĹҲ־ָļ޷ȡʱط
+ */
+static int load_data(int read_only) {
+    checkpoint_finish(1);                        /* Ⱥ̨дļ */
+    wal_close();                                 /* ¼ʱȹرվ־ */
+    data_damaged = 0;
+    journal_skipped = 0;
+    if (read_only && !wal_pending(JOURNAL_FILE_NAME) &&
+        !wal_pending(ROTATED_JOURNAL_FILE_NAME)) {        /* ־Ϊʱļ״̬ */
+        int mapped = map_player_data_file(DATA_FILE_NAME);
+        if (mapped >= 0) {
+            return mapped;
+        }
+    }
+    int loaded = load_player_data_from_file(DATA_FILE_NAME);
+    data_damaged = loaded < 0 || corrupt_record_report(NULL) > 0;
+    if (loaded < 0) {
+        journal_skipped = 1;
+        return loaded;                           /* ļ޷ȡ־ȷϸʱһ */
+    }
+    wal_replay(ROTATED_JOURNAL_FILE_NAME);       /* ϴμδʱľ־ */
+    if (read_only || data_damaged) {
+        wal_replay(JOURNAL_FILE_NAME);           /* ֻģʽļʱֻطţд־ */
+    } else if (wal_open(JOURNAL_FILE_NAME) >= 0 && wal_discarded_bytes() > 0) {   /* طź׷ */
+        set_console_color(COLOR_ERROR);
+        printf("ע⣺־вȱļ¼ѽȥ %ld ֽڣǰĸĶѻָ\n",
+               wal_discarded_bytes());
+        set_console_color(COLOR_DEFAULT);
+    }
+    return player_store.count;
+}
+
+/*
+ * print_corrupt_records
+ * ܣгУֵļ¼ļе˳1ţûʱ
+ * 
+ */
+static void print_corrupt_records(void) {
+    int slots[CORRUPT_REPORT_LIMIT];
+    int count = corrupt_record_report(slots);
+    if (count > 0) {
+        printf("Уʧܵļ¼%d", count);
+        for (int i = 0; i < count && i < CORRUPT_REPORT_LIMIT; i++) {
+            printf("%s%d", i > 0 ? "" : "", slots[i] + 1);
+        }
+        printf(count > CORRUPT_REPORT_LIMIT ? "\n" : "\n");
+    }
+}
+
+/*
+ * report_damaged_data
+ * ܣļʱ˵ؽгУֵļ¼
+ * loaded - load_dataķֵ, read_only - 1ʾֻģʽ
+ */
+static void report_damaged_data(int loaded, int read_only) {
+    set_console_color(COLOR_ERROR);
+    if (loaded < 0) {
+        printf("棺ļ𻵻ʽ޷ʶδκ\n");
+    } else {
+        printf("棺ļ𻵣Уʧܵļ¼ %d ԱѼ\n", loaded);
+    }
+    print_corrupt_records();                     /* ûʱ𻵵ļͷƱļβ */
+    if (!read_only) {
+        printf("ԭļᱻԶǣʱȷ\n");
+    }
+    set_console_color(COLOR_DEFAULT);
+}
+
+/*
+ * set_aside_file
+ * ܣļΪԭDAMAGED_FILE_SUFFIXһαͬļ
+ * path - ļ
+ * ֵ1ʾѸļڣ0ʾʧ
+ */
+static int set_aside_file(const char* path) {
+    FILE* file_ptr = fopen(path, "rb");
+    if (file_ptr == NULL) {
+        return 1;                                /* ļڣ豣 */
+    }
+    fclose(file_ptr);
+    char backup[300];
+    snprintf(backup, sizeof(backup), "%s%s", path, DAMAGED_FILE_SUFFIX);
+    remove(backup);
+    return rename(path, backup) == 0;
+}
+
+/*
+ * overwrite_damaged_data
+ * ܣļʱûȷϺԵǰдļ
+ * 
+ * ֵ1ʾд룬0ʾûδȷϻдʧ
+ * ˼·δȷʱļ־һֽڶĶȷϺԭļ־
+ *           ȸ־طŵǰ洢УļҪǣ
+ *           ½־дļ˺ָ־㣻
+ *           ļ޷ȡʱ־δطţеĸĶдļʾ˵
+ */
+static int overwrite_damaged_data(void) {
+    char answer[16];
+    set_console_color(COLOR_ERROR);
+    printf("ļ𻵣潫Եǰ %d Աԭļ\n", player_store.count);
+    if (journal_skipped &&
+        (wal_pending(JOURNAL_FILE_NAME) || wal_pending(ROTATED_JOURNAL_FILE_NAME))) {
+        printf("־δļĸĶ޷طţǺ󽫱\n");
+    }
+    printf("ԭļ־Ϊ*%sȷϸ(y/N): ", DAMAGED_FILE_SUFFIX);
+    set_console_color(COLOR_DEFAULT);
+    if (fgets(answer, sizeof(answer), stdin) == NULL || (answer[0] != 'y' && answer[0] != 'Y')) {
+        printf("δǣļֲ\n");
+        return 0;
+    }
+    if (!set_aside_file(DATA_FILE_NAME) || !set_aside_file(JOURNAL_FILE_NAME) ||
+        !set_aside_file(ROTATED_JOURNAL_FILE_NAME) || wal_open(JOURNAL_FILE_NAME) < 0) {
+        return 0;                                /* Դ״̬Ժ */
+    }
+    data_damaged = 0;
+    journal_skipped = 0;
+    return checkpoint_start(DATA_FILE_NAME, ROTATED_JOURNAL_FILE_NAME, 0);
+}
+
+/*
+ * save_data
+ * ܣݣ־ʱֻ־ˢµ̣дļ
+ * 
+ * ֵ1ʾɹ0ʾʧ
+ * ˵ļʱ뾭ûȷϲд루overwrite_damaged_data
+ */
+static int save_data(void) {
+    if (data_damaged) {
+        return overwrite_damaged_data();
+    }
+    return wal_commit() || checkpoint_start(DATA_FILE_NAME, ROTATED_JOURNAL_FILE_NAME, 0);
+}
+
+/*
+ * browse_leaderboard
+ * ܣѡΧȫӻλãҳЧа
+ * 
+ */
+static void browse_leaderboard(void) {
+    char input_buffer[40];
+    printf("\n鿴Ча1-ȫ 2- 3-λãأ: ");
+    if (fgets(input_buffer, sizeof(input_buffer), stdin) == NULL) return;
+    
+    int choice = atoi(input_buffer);
+    LeaderboardScope scope = LEADERBOARD_LEAGUE;
+    int key = 0;                                 /* ӱŻλ */
+    char title[40] = "ȫ";
+    if (choice == 2) {
+        printf(": ");
+        if (fgets(title, sizeof(title), stdin) == NULL) return;
+        title[strcspn(title, "\n")] = 0;         /* ȥз */
+        scope = LEADERBOARD_TEAM;
+        key = team_pool_find(title);
+        if (key < 0) {
+            set_console_color(COLOR_ERROR);
+            printf("δҵ %s\n", title);
+            set_console_color(COLOR_DEFAULT);
+            return;
+        }
+    } else if (choice == 3) {
+        printf("λ(PG/SG/SF/PF/C): ");
+        if (fgets(title, sizeof(title), stdin) == NULL) return;
+        title[strcspn(title, "\n")] = 0;         /* ȥз */
+        scope = LEADERBOARD_POSITION;
+        key = position_from_name(title);
+        if (key == POSITION_INVALID) {
+            set_console_color(COLOR_ERROR);
+            printf("λñPG/SG/SF/PF/C֮һ\n");
+            set_console_color(COLOR_DEFAULT);
+            return;
+        }
+    } else if (choice != 1) {
+        return;
+    }
+    
+    if (!ensure_player_indexes(INDEX_LEADERBOARD)) {   /* ֻӳģʽ״ʱ */
+        set_console_color(COLOR_ERROR);
+        printf("ڴ治㣬޷Ча\n");
+        set_console_color(COLOR_DEFAULT);
+        return;
+    }
+    for (int first_rank = 1; ; first_rank += LEADERBOARD_PAGE_SIZE) {
+        display_efficiency_leaderboard(scope, key, title, first_rank);
+        if (first_rank + LEADERBOARD_PAGE_SIZE > leaderboard_size(scope, key)) {
+            break;                               /* һҳ */
+        }
+        printf("س鿴һҳq: ");
+        if (fgets(input_buffer, sizeof(input_buffer), stdin) == NULL ||
+            input_buffer[0] == 'q' || input_buffer[0] == 'Q') {
+            break;
+        }
+    }
+}
 
 /*
  * main
  * ߣĿ
  * ܣڣ
  * ƣѭ˵ûѡӦ
+ * в --readonly ֻģʽļӳ䷽ʽ򿪣
+ *       ʱļС޹أ/޸/ɾ/ã
+ *       --check ݺ˶ͳƻ¼Ľ˵
+ *       һʱ˳Ϊ0һ»ļʱΪ1
  */
-int main() {
+int main(int argc, char* argv[]) {
+    int read_only = argc > 1 && strcmp(argv[1], "--readonly") == 0;   /* ֻģʽ */
+    
+    if (argc > 1 && strcmp(argv[1], "--check") == 0) {   /* ˶ģʽ޸κļ */
+        int loaded = load_data(1);
+        if (data_damaged) {
+            report_damaged_data(loaded, 1);
+            return 1;
+        }
+        int mismatches = check_stats_aggregates();   /* ӳļ¼ڴʱ˶ */
+        printf("ͳƻܺ˶ɣ%d Ա%d һ\n", player_store.count, mismatches);
+        if (skipped_player_records() > 0) {
+            printf(" %d ¼𻵻ӱԽ磬δͳƻ\n", skipped_player_records());
+        }
+        if (corrupt_record_report(NULL) > 0) {
+            set_console_color(COLOR_ERROR);
+            printf("棺ļ\n");
+            print_corrupt_records();
+            set_console_color(COLOR_DEFAULT);
+            return 1;
+        }
+        return mismatches == 0 ? 0 : 1;
+    }
+    
     display_welcome_animation();                 /* ʾӭ */
-    load_player_data_from_file("players.dat");   /* ʱ */
+    int loaded = load_data(read_only);           /* ʱ */
+    if (data_damaged) {
+        report_damaged_data(loaded, read_only);
+    }
+    if (!read_only) {
+        autosave_start(AUTOSAVE_INTERVAL_MS, AUTOSAVE_DIRTY_ENTRIES);   /* ־ں̨ */
+    }
     
     int user_choice = -1;                        /* ûѡʼ */
     char input_buffer[100];                      /* 뻺 */
+    int reported_skipped = 0;                    /* ʾδǼǼ¼ */
     
     do {
         display_main_menu();                     /* ʾ˵ */
@@ -37,6 +290,16 @@ int main() {
         
         user_choice = atoi(input_buffer);        /* תΪ */
         
+        if (read_only && (user_choice == 1 || user_choice == 5 ||
+                          user_choice == 6 || user_choice == 10)) {
+            set_console_color(COLOR_ERROR);
+            printf("ֻģʽ²޸Ļ򱣴ݣ\n");
+            set_console_color(COLOR_DEFAULT);
+            printf("\nس˵...");
+            getchar();                           /* ȴû */
+            continue;
+        }
+        
         switch (user_choice) {                   /* ûѡ֧ */
             case 1: {  /* Ա */
                 char id[13], name[21], team[31], position[11];
@@ -107,16 +370,47 @@ int main() {
                 break;
             }
                 
-            case 4: {  /*  */
+            case 4: {  /* ңгȫͬԱ֧ǰ׺ң */
                 char name[21];
-                printf("\n: ");
+                PlayerHandle matches[NAME_SEARCH_LIMIT];
+                printf("\nͷ: ");
                 fgets(name, sizeof(name), stdin);
                 name[strcspn(name, "\n")] = 0;    /* ȥз */
                 
-                Player* found = search_player_by_name(name);
-                if (found != NULL) {
-                    display_player_card(found);
-                } else {
+                if (name[0] == '\0') {
+                    set_console_color(COLOR_ERROR);
+                    printf("Ϊ\n");
+                    set_console_color(COLOR_DEFAULT);
+                    break;
+                }
+                
+                /* һ֣ȫͬԱʾƬ */
+                int exact_count = search_players_by_name(name, matches, NAME_SEARCH_LIMIT);
+                for (int i = 0; i < exact_count && i < NAME_SEARCH_LIMIT; i++) {
+                    display_player_card(player_store_get(matches[i]));
+                }
+                if (exact_count > NAME_SEARCH_LIMIT) {
+                    printf("ͬԱ %d ˣʾǰ %d \n", exact_count, NAME_SEARCH_LIMIT);
+                }
+                
+                /* ڶ֣ݿͷԱҪг */
+                int prefix_count = search_players_by_name_prefix(name, matches, NAME_SEARCH_LIMIT);
+                if (prefix_count > exact_count) {
+                    set_console_color(COLOR_HIGHLIGHT);
+                    printf("\n %s ͷԱ %d ˣ\n", name, prefix_count - exact_count);
+                    set_console_color(COLOR_DEFAULT);
+                    for (int i = 0; i < prefix_count && i < NAME_SEARCH_LIMIT; i++) {
+                        const Player* player = player_store_get(matches[i]);
+                        if (strcmp(player->name, name) == 0) continue;   /* ͬʾ */
+                        printf("  %s  %-20s %-30s %s\n", player->id, player->name,
+                               team_pool_name(player->team_id), position_name(player->position));
+                    }
+                    if (prefix_count > NAME_SEARCH_LIMIT) {
+                        printf("  ʾǰ %d \n", NAME_SEARCH_LIMIT);
+                    }
+                }
+                
+                if (prefix_count == 0) {
                     set_console_color(COLOR_ERROR);
                     printf("δҵΪ %s Ա\n", name);
                     set_console_color(COLOR_DEFAULT);
@@ -164,45 +458,44 @@ int main() {
         break;
     }
     
-    Player temp_player;  /* ʱ洢޸ǰ */
-    memcpy(&temp_player, player, sizeof(Player));
+    int updated = 0;  /* ޸ĽϷʱupdate_player_by_idԭݲ */
     
     switch (choice) {
         case 1:
             printf(": ");
             fgets(new_name, sizeof(new_name), stdin);
             new_name[strcspn(new_name, "\n")] = 0;
-            strcpy(player->name, new_name);
+            updated = update_player_by_id(id, choice, new_name);
             break;
         case 2:
             printf(": ");
             fgets(new_team, sizeof(new_team), stdin);
             new_team[strcspn(new_team, "\n")] = 0;
-            strcpy(player->team, new_team);
+            updated = update_player_by_id(id, choice, new_team);
             break;
         case 3:
             printf("λ(PG/SG/SF/PF/C): ");
             scanf("%10s", new_position);
             clear_input_buffer();
-            strcpy(player->position, new_position);
+            updated = update_player_by_id(id, choice, new_position);
             break;
         case 4:
             printf("(cm): ");
             scanf("%d", &new_height);
             clear_input_buffer();
-            player->height = new_height;
+            updated = update_player_by_id(id, choice, &new_height);
             break;
         case 5:
             printf("(kg): ");
             scanf("%d", &new_weight);
             clear_input_buffer();
-            player->weight = new_weight;
+            updated = update_player_by_id(id, choice, &new_weight);
             break;
         case 6:
             printf("º(0-99): ");
             scanf("%d", &new_jersey);
             clear_input_buffer();
-            player->jersey = new_jersey;
+            updated = update_player_by_id(id, choice, &new_jersey);
             break;
         default:
             set_console_color(COLOR_ERROR);
@@ -211,15 +504,13 @@ int main() {
             break;
     }
     
-    /* ֤޸ĺ */
+    /* ޸Ľ */
     if (choice >= 1 && choice <= 6) {
-        if (validate_player_data(player)) {
+        if (updated) {
             set_console_color(COLOR_SUCCESS);
             printf("޸ĳɹ\n");
             set_console_color(COLOR_DEFAULT);
         } else {
-            /* ֤ʧܣָԭ */
-            memcpy(player, &temp_player, sizeof(Player));
             set_console_color(COLOR_ERROR);
             printf("޸ʧܣݲϷѻָԭ\n");
             set_console_color(COLOR_DEFAULT);
@@ -259,13 +550,14 @@ int main() {
                 break;
             }
                 
-            case 9: {  /* ЧԱ */
+            case 9: {  /* ЧԱЧа */
                 Player* best = find_most_efficient_player();
                 if (best != NULL) {
                     set_console_color(COLOR_HIGHLIGHT);
                     printf("\n=== ЧԱ ===\n");
                     set_console_color(COLOR_DEFAULT);
                     display_player_card(best);
+                    browse_leaderboard();        /* ɼ鿴а */
                 } else {
                     set_console_color(COLOR_ERROR);
                     printf("Ա\n");
@@ -274,8 +566,8 @@ int main() {
                 break;
             }
                 
-            case 10:  /*  */
-                if (save_player_data_to_file("players.dat") > 0) {
+            case 10:  /* ݣĶ־˴ֻ */
+                if (save_data()) {
                     set_console_color(COLOR_SUCCESS);
                     printf("? ݱɹ\n");
                     set_console_color(COLOR_DEFAULT);
@@ -286,8 +578,11 @@ int main() {
                 }
                 break;
                 
-            case 11:  /*  */
-                if (load_player_data_from_file("players.dat") > 0) {
+            case 11: {  /*  */
+                int loaded = load_data(read_only);
+                if (data_damaged) {
+                    report_damaged_data(loaded, read_only);
+                } else if (loaded > 0) {
                     set_console_color(COLOR_SUCCESS);
                     printf("? ݼسɹ\n");
                     set_console_color(COLOR_DEFAULT);
@@ -297,16 +592,26 @@ int main() {
                     set_console_color(COLOR_DEFAULT);
                 }
                 break;
+            }
                 
-            case 0:  /* ˳ϵͳ */
-                if (save_player_data_to_file("players.dat") > 0) {
-                    set_console_color(COLOR_SUCCESS);
-                    printf("? Զ\n");
+            case 0: {  /* ˳ϵͳҪʱļֻ */
+                if (!read_only) {
+                    autosave_stop();             /* µĸĶ浱 */
+                    checkpoint_finish(1);        /* Ⱥ̨ */
+                    int saved = (!data_damaged && checkpoint_due(ROTATED_JOURNAL_FILE_NAME) &&
+                                 checkpoint_start(DATA_FILE_NAME, ROTATED_JOURNAL_FILE_NAME, 0)) ||
+                                save_data();     /* ļʱûȷǷ񸲸 */
+                    if (saved) {
+                        set_console_color(COLOR_SUCCESS);
+                        printf("? Զ\n");
+                    }
+                    wal_close();
                 }
                 set_console_color(COLOR_HIGHLIGHT);
                 printf("лʹôѧݹϵͳ\n");
                 set_console_color(COLOR_DEFAULT);
                 break;
+            }
                 
             default:  /* Ч */
                 set_console_color(COLOR_ERROR);
@@ -314,6 +619,42 @@ int main() {
                 set_console_color(COLOR_DEFAULT);
         }
         
+        if (!read_only && !data_damaged && user_choice != 0) {   /* ־̨̣־ϳϾδʱ̨м */
+            if (journal_write_failed()) {        /* Ķδܼ־дļ */
+                int written = checkpoint_start(DATA_FILE_NAME, ROTATED_JOURNAL_FILE_NAME, 0);
+                set_console_color(COLOR_ERROR);
+                printf(written ? "ע⣺־дʧܣĶֱдļ\n"
+                               : "ע⣺־дʧܣдļҲʧܣѡ񱣴\n");
+                set_console_color(COLOR_DEFAULT);
+            }
+            autosave_notify();                   /* ȴ̣θĶϲΪһͬ */
+            if (autosave_failed()) {
+                set_console_color(COLOR_ERROR);
+                printf("ע⣺־дʧܣѡ񱣴дļ\n");
+                set_console_color(COLOR_DEFAULT);
+            }
+            int finished = checkpoint_finish(0); /* ѽһ */
+            if (finished != 0 && checkpoint_due(ROTATED_JOURNAL_FILE_NAME)) {
+                finished = checkpoint_start(DATA_FILE_NAME, ROTATED_JOURNAL_FILE_NAME, 1) ? -1 : 0;
+            }
+            if (finished == 0) {
+                set_console_color(COLOR_ERROR);
+                printf("ע⣺дļʧܣĶԱ־УԺ\n");
+                set_console_color(COLOR_DEFAULT);
+            }
+        }
+        
+        int skipped = skipped_player_records();  /* ֻӳģʽ״νʱŻᷢ */
+        if (skipped != reported_skipped) {
+            reported_skipped = skipped;
+            if (skipped > 0) {
+                set_console_color(COLOR_ERROR);
+                printf("ע⣺ļ %d ¼𻵻ӱԽ磬δѯͳа\n", skipped);
+                print_corrupt_records();
+                set_console_color(COLOR_DEFAULT);
+            }
+        }
+        
         if (user_choice != 0) {                  /* ˳ѡʱͣ */
             printf("\nس˵...");
             getchar();                           /* ȴû */
@@ -68,7 +68,7 @@ void display_main_menu() {
     printf("   6. ɾԱ¼                            \n");
     printf("   7. Աͳ                            \n");
     printf("   8. ݷ                            \n");
-    printf("   9. ЧԱ                        \n");
+    printf("   9. ЧԱа                    \n");
     printf("  10. ݵļ                          \n");
     printf("  11. ļ                          \n");
     printf("   0. ˳ϵͳ                            \n");
@@ -0,0 +1,554 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "data_struct.h"
+#include "player_store.h"
+#include "record_pool.h"
+#include "parallel.h"
+#include "name_index.h"
+
+/*
+ * ϣӳڵ㣺ͬһͰڵĽڵԵ
+ * ڵ㻺ϣֵֻйϣͬʱŷԱ¼Ƚ
+ */
+typedef struct NameIndexNode {
+    unsigned int hash;              /* ϣֵ */
+    PlayerHandle handle;            /* Ա */
+    struct NameIndexNode* next;     /* ͬͰһڵ */
+} NameIndexNode;
+
+/*
+ * ؽʱԪأ׷һźúݴ˽ƽ
+ * Ϊ(ֽ, )ΨһÿԪλȷ
+ */
+typedef struct NameSortEntry {
+    char name[21];                  /*  */
+    PlayerHandle handle;            /* Ա */
+} NameSortEntry;
+
+/*
+ * ڵ㣺(, )AVLౣ
+ * Ǽעڼ¼޸֮ǰУȽʱܶȡ洢еļ¼
+ */
+typedef struct NameTreeNode {
+    char name[21];                  /*  */
+    PlayerHandle handle;            /* Ա */
+    int height;                     /* ߶ȣҶΪ1 */
+    struct NameTreeNode* left;      /* С */
+    struct NameTreeNode* right;     /* ϴ */
+} NameTreeNode;
+
+static NameIndexNode** hash_buckets = NULL;  /* ϣͰ飬Ϊ2 */
+static int hash_bucket_count = 0;            /* ϣͰ */
+static int hash_node_count = 0;              /* ڵ */
+static RecordPool node_pool = RECORD_POOL_INIT(NameIndexNode, 4096);  /* ڵ */
+
+static NameTreeNode* tree_root = NULL;       /* ڵ */
+static RecordPool tree_pool = RECORD_POOL_INIT(NameTreeNode, 4096);   /* ڵ */
+
+static NameSortEntry* sorted_entries = NULL; /* ؽʱ飬ͷ */
+static int sorted_count = 0;                 /* ЧԪ */
+static int sorted_capacity = 0;              /*  */
+
+#define NAME_INDEX_MIN_BUCKETS 64            /* СͰ */
+#define PARALLEL_SORT_MIN_ENTRIES 65536      /* ÿ߳ٷֵԪ */
+#define NAME_TREE_MAX_HEIGHT 64              /* ߶Ͻ磺AVL߶ԼΪ1.44log2(n)intΧڵĽڵ45 */
+
+/*
+ * hash_name
+ * ܣֽڴFNV-1aϣֵ
+ */
+static unsigned int hash_name(const char* name) {
+    unsigned int hash = 2166136261u;            /* FNVƫƻ */
+    while (*name != '\0') {
+        hash ^= (unsigned char)*name++;
+        hash *= 16777619u;                      /* FNV */
+    }
+    return hash;
+}
+
+/*
+ * resize_hash
+ * ܣͰ·ֲȫڵ
+ */
+static int resize_hash(int new_bucket_count) {
+    NameIndexNode** table = (NameIndexNode**)calloc((size_t)new_bucket_count, sizeof(NameIndexNode*));
+    if (table == NULL) {
+        return 0;                               /* ڴ治㣬ԭֲ */
+    }
+    for (int i = 0; i < hash_bucket_count; i++) {
+        NameIndexNode* node = hash_buckets[i];
+        while (node != NULL) {                  /* ڵǨƵͰ */
+            NameIndexNode* next = node->next;
+            int pos = (int)(node->hash & (unsigned int)(new_bucket_count - 1));
+            node->next = table[pos];
+            table[pos] = node;
+            node = next;
+        }
+    }
+    free(hash_buckets);
+    hash_buckets = table;
+    hash_bucket_count = new_bucket_count;
+    return 1;
+}
+
+/*
+ * compare_entry
+ * ܣ(, )ȽԪ
+ */
+static int compare_entry(const char* name_a, PlayerHandle handle_a,
+                         const char* name_b, PlayerHandle handle_b) {
+    int result = strcmp(name_a, name_b);        /* strcmp޷ֽڱȽ */
+    if (result != 0) return result;
+    return (handle_a > handle_b) - (handle_a < handle_b);
+}
+
+static int compare_sort_entries(const void* a, const void* b) {
+    const NameSortEntry* ea = (const NameSortEntry*)a;
+    const NameSortEntry* eb = (const NameSortEntry*)b;
+    return compare_entry(ea->name, ea->handle, eb->name, eb->handle);
+}
+
+/*
+ * Σһ̸߳һΣϲ
+ */
+typedef struct SortRun {
+    NameSortEntry* source;          /*  */
+    NameSortEntry* target;          /* ϲ飨ʱã */
+    int first;                      /* һ */
+    int middle;                     /* ڶ㣨ʱյ㣩 */
+    int last;                       /* ڶյ */
+} SortRun;
+
+/*
+ * sort_run
+ * ܣһԪִ߳У
+ */
+static void sort_run(void* arg) {
+    SortRun* run = (SortRun*)arg;
+    qsort(run->source + run->first, (size_t)(run->middle - run->first),
+          sizeof(NameSortEntry), compare_sort_entries);
+}
+
+/*
+ * merge_runs
+ * ܣڵԪغϲдĿͬλãִ߳У
+ */
+static void merge_runs(void* arg) {
+    SortRun* run = (SortRun*)arg;
+    int a = run->first, b = run->middle, out = run->first;
+    while (a < run->middle && b < run->last) {
+        run->target[out++] = compare_sort_entries(&run->source[b], &run->source[a]) < 0
+                             ? run->source[b++] : run->source[a++];
+    }
+    while (a < run->middle) run->target[out++] = run->source[a++];
+    while (b < run->last) run->target[out++] = run->source[b++];
+}
+
+/*
+ * sort_entries
+ * ܣȫԪ
+ * ˼·Ԫؽ϶ʱг߳ͬĶΣͬʱϲ
+ *           ÿֵĸκϲͬʱУΨһһͬ
+ *           ϲҪͬСʱ飬ڴ治ʱ˻ص߳
+ */
+static void sort_entries(void) {
+    int workers = parallel_worker_count(sorted_count, PARALLEL_SORT_MIN_ENTRIES);
+    NameSortEntry* spare = workers > 1
+        ? (NameSortEntry*)malloc((size_t)sorted_capacity * sizeof(NameSortEntry)) : NULL;
+    if (spare == NULL) {
+        qsort(sorted_entries, (size_t)sorted_count, sizeof(NameSortEntry), compare_sort_entries);
+        return;
+    }
+    
+    int bounds[PARALLEL_MAX_WORKERS + 1];        /* 㣬ĩΪԪ */
+    SortRun runs[PARALLEL_MAX_WORKERS];
+    for (int w = 0; w <= workers; w++) {
+        bounds[w] = (int)((long long)sorted_count * w / workers);
+    }
+    for (int w = 0; w < workers; w++) {
+        runs[w].source = sorted_entries;
+        runs[w].first = bounds[w];
+        runs[w].middle = bounds[w + 1];
+    }
+    parallel_run(sort_run, runs, sizeof(SortRun), workers);
+    
+    int run_count = workers;                     /* ǰ */
+    while (run_count > 1) {
+        int merges = 0;
+        for (int r = 0; r < run_count; r += 2) {
+            int last = bounds[r + 2 <= run_count ? r + 2 : r + 1];   /* 䵥һԭ */
+            runs[merges].source = sorted_entries;
+            runs[merges].target = spare;
+            runs[merges].first = bounds[r];
+            runs[merges].middle = bounds[r + 1];
+            runs[merges].last = last;
+            bounds[merges++] = bounds[r];
+        }
+        bounds[merges] = sorted_count;
+        parallel_run(merge_runs, runs, sizeof(SortRun), merges);
+        NameSortEntry* merged = spare;           /* Ϊһ */
+        spare = sorted_entries;
+        sorted_entries = merged;
+        run_count = merges;
+    }
+    free(spare);
+}
+
+/*
+ * reserve_sorted
+ * ܣ֤min_capacityԪ
+ */
+static int reserve_sorted(int min_capacity) {
+    if (min_capacity <= sorted_capacity) return 1;
+    int new_capacity = sorted_capacity > 0 ? sorted_capacity : 16;
+    while (new_capacity < min_capacity) {
+        new_capacity *= 2;                      /*  */
+    }
+    NameSortEntry* entries = (NameSortEntry*)realloc(sorted_entries,
+                                                     (size_t)new_capacity * sizeof(NameSortEntry));
+    if (entries == NULL) return 0;
+    sorted_entries = entries;
+    sorted_capacity = new_capacity;
+    return 1;
+}
+
+/*
+ * node_height / update_height / rotate_left / rotate_right / rebalance
+ * ܣAVLĸ߶άתrebalance߶Ȳ1ʱתµ
+ */
+static int node_height(const NameTreeNode* node) {
+    return node != NULL ? node->height : 0;
+}
+
+static void update_height(NameTreeNode* node) {
+    int left = node_height(node->left), right = node_height(node->right);
+    node->height = (left > right ? left : right) + 1;
+}
+
+static NameTreeNode* rotate_right(NameTreeNode* node) {
+    NameTreeNode* pivot = node->left;
+    node->left = pivot->right;
+    pivot->right = node;
+    update_height(node);
+    update_height(pivot);
+    return pivot;
+}
+
+static NameTreeNode* rotate_left(NameTreeNode* node) {
+    NameTreeNode* pivot = node->right;
+    node->right = pivot->left;
+    pivot->left = node;
+    update_height(node);
+    update_height(pivot);
+    return pivot;
+}
+
+static NameTreeNode* rebalance(NameTreeNode* node) {
+    update_height(node);
+    int balance = node_height(node->left) - node_height(node->right);
+    if (balance > 1) {                          /*  */
+        if (node_height(node->left->left) < node_height(node->left->right)) {
+            node->left = rotate_left(node->left);
+        }
+        return rotate_right(node);
+    }
+    if (balance < -1) {                         /*  */
+        if (node_height(node->right->right) < node_height(node->right->left)) {
+            node->right = rotate_right(node->right);
+        }
+        return rotate_left(node);
+    }
+    return node;
+}
+
+/*
+ * tree_insert
+ * ܣõĽڵµ
+ */
+static NameTreeNode* tree_insert(NameTreeNode* root, NameTreeNode* node) {
+    if (root == NULL) {
+        return node;
+    }
+    if (compare_entry(node->name, node->handle, root->name, root->handle) < 0) {
+        root->left = tree_insert(root->left, node);
+    } else {
+        root->right = tree_insert(root->right, node);
+    }
+    return rebalance(root);
+}
+
+/*
+ * tree_remove
+ * ܣɾ(name, handle)ڵ㣬µ*removedΪ1ʾҵ
+ * ˵ӽڵʱѺ̽ڵ뱾ڵ㣬ɾ̽ڵ
+ */
+static NameTreeNode* tree_remove(NameTreeNode* root, const char* name, PlayerHandle handle, int* removed) {
+    if (root == NULL) {
+        return NULL;                            /* δǼ */
+    }
+    int order = compare_entry(name, handle, root->name, root->handle);
+    if (order < 0) {
+        root->left = tree_remove(root->left, name, handle, removed);
+    } else if (order > 0) {
+        root->right = tree_remove(root->right, name, handle, removed);
+    } else if (root->left == NULL || root->right == NULL) {
+        NameTreeNode* child = root->left != NULL ? root->left : root->right;
+        record_pool_free(&tree_pool, root);
+        *removed = 1;
+        return child;
+    } else {
+        const NameTreeNode* successor = root->right;
+        while (successor->left != NULL) {
+            successor = successor->left;
+        }
+        memcpy(root->name, successor->name, sizeof(root->name));
+        root->handle = successor->handle;
+        root->right = tree_remove(root->right, root->name, root->handle, removed);
+    }
+    return rebalance(root);
+}
+
+/*
+ * build_tree
+ * ܣźsorted_entries[first, last)ȫƽ
+ * ֵ䷵NULLڴ治ʱ*failedΪ1
+ */
+static NameTreeNode* build_tree(int first, int last, int* failed) {
+    if (first >= last || *failed) {
+        return NULL;
+    }
+    int middle = first + (last - first) / 2;
+    NameTreeNode* node = (NameTreeNode*)record_pool_alloc(&tree_pool);
+    if (node == NULL) {
+        *failed = 1;
+        return NULL;
+    }
+    memcpy(node->name, sorted_entries[middle].name, sizeof(node->name));
+    node->handle = sorted_entries[middle].handle;
+    node->left = build_tree(first, middle, failed);
+    node->right = build_tree(middle + 1, last, failed);
+    update_height(node);
+    return node;
+}
+
+/*
+ * name_index_insert
+ * ܣǼĶӦϵ
+ * name - Ա, handle - Ա
+ * ֵ1ʾɹ0ʾڴ治
+ * ʱ临ӶȣϣO(1)O(log n)
+ */
+int name_index_insert(const char* name, PlayerHandle handle) {
+    /* һԤڵ䣬֤벻;ʧ */
+    if (hash_node_count + 1 > hash_bucket_count) {    /* ӳ1ʱ */
+        int new_count = hash_bucket_count > 0 ? hash_bucket_count * 2 : NAME_INDEX_MIN_BUCKETS;
+        if (!resize_hash(new_count)) return 0;
+    }
+    NameIndexNode* node = (NameIndexNode*)record_pool_alloc(&node_pool);
+    if (node == NULL) return 0;
+    NameTreeNode* tree_node = (NameTreeNode*)record_pool_alloc(&tree_pool);
+    if (tree_node == NULL) {
+        record_pool_free(&node_pool, node);
+        return 0;
+    }
+
+    /* ڶϣӳ䣨ͷ壩 */
+    node->hash = hash_name(name);
+    node->handle = handle;
+    int pos = (int)(node->hash & (unsigned int)(hash_bucket_count - 1));
+    node->next = hash_buckets[pos];
+    hash_buckets[pos] = node;
+    hash_node_count++;
+
+    /*  */
+    memset(tree_node->name, 0, sizeof(tree_node->name));
+    strncpy(tree_node->name, name, sizeof(tree_node->name) - 1);
+    tree_node->handle = handle;
+    tree_node->height = 1;
+    tree_node->left = NULL;
+    tree_node->right = NULL;
+    tree_root = tree_insert(tree_root, tree_node);
+    return 1;
+}
+
+/*
+ * name_index_remove
+ * ܣƳĶӦϵڼ¼޸֮ǰã
+ * name - Ǽʱʹõ, handle - Ա
+ * ֵ1ʾƳɹ0ʾδǼ
+ * ʱ临ӶȣϣO(1)O(log n)
+ */
+int name_index_remove(const char* name, PlayerHandle handle) {
+    if (hash_bucket_count == 0) return 0;       /*  */
+
+    /* һӹϣͰժڵ */
+    unsigned int hash = hash_name(name);
+    NameIndexNode** link = &hash_buckets[hash & (unsigned int)(hash_bucket_count - 1)];
+    while (*link != NULL && !((*link)->hash == hash && (*link)->handle == handle)) {
+        link = &(*link)->next;
+    }
+    if (*link == NULL) return 0;                /* δǼ */
+    NameIndexNode* node = *link;
+    *link = node->next;
+    record_pool_free(&node_pool, node);
+    hash_node_count--;
+
+    /* ڶɾΪضϺĸͬʽضٲң */
+    char key[sizeof(tree_root->name)] = {0};
+    strncpy(key, name, sizeof(key) - 1);
+    int removed = 0;
+    tree_root = tree_remove(tree_root, key, handle, &removed);
+    return 1;
+}
+
+/*
+ * name_index_find_exact
+ * ܣnameȫͬȫԱ
+ * name - , results - , max_results - 
+ * ֵƥܴmax_resultsǰmax_resultsдresults
+ */
+int name_index_find_exact(const char* name, PlayerHandle* results, int max_results) {
+    if (hash_bucket_count == 0) return 0;       /*  */
+    unsigned int hash = hash_name(name);
+    int total = 0;                              /* ƥ */
+    NameIndexNode* node = hash_buckets[hash & (unsigned int)(hash_bucket_count - 1)];
+    while (node != NULL) {                      /* ֻһͰ */
+        if (node->hash == hash) {               /* ϣͬűȽ */
+            const Player* player = player_store_get(node->handle);
+            if (player != NULL && strcmp(player->name, name) == 0) {
+                if (total < max_results) {
+                    results[total] = node->handle;
+                }
+                total++;
+            }
+        }
+        node = node->next;
+    }
+    return total;
+}
+
+/*
+ * name_index_find_prefix
+ * ܣprefixͷȫԱֽ
+ * prefix - ǰ׺, results - , max_results - 
+ * ֵƥܴmax_resultsǰmax_resultsдresults
+ * 㷨½ҵһСprefixĽڵ㣬ֱٰǰ׺ƥ䣬
+ *       O(log n + )ʵĽڵ㱣ջУȲ
+ */
+int name_index_find_prefix(const char* prefix, PlayerHandle* results, int max_results) {
+    size_t prefix_length = strlen(prefix);
+    const NameTreeNode* pending[NAME_TREE_MAX_HEIGHT];   /* СprefixδʵȽڵ */
+    int depth = 0;
+    const NameTreeNode* node = tree_root;
+    while (node != NULL) {                      /* λһСprefixĽڵ */
+        if (compare_entry(node->name, node->handle, prefix, INVALID_PLAYER_HANDLE) >= 0) {
+            pending[depth++] = node;
+            node = node->left;
+        } else {
+            node = node->right;
+        }
+    }
+    
+    int total = 0;                              /* ƥ */
+    while (depth > 0) {
+        node = pending[--depth];
+        if (strncmp(node->name, prefix, prefix_length) != 0) {
+            break;                              /* ƥƥ伴 */
+        }
+        if (total < max_results) {
+            results[total] = node->handle;
+        }
+        total++;
+        for (node = node->right; node != NULL; node = node->left) {   /* ڵ */
+            pending[depth++] = node;
+        }
+    }
+    return total;
+}
+
+/*
+ * clear_hash
+ * ܣȫϣڵڵ㣬Ͱ
+ * ˵ڵɶգͷ
+ */
+static void clear_hash(void) {
+    for (int i = 0; i < hash_bucket_count; i++) {
+        hash_buckets[i] = NULL;
+    }
+    hash_node_count = 0;
+    record_pool_reset(&node_pool);
+    tree_root = NULL;
+    record_pool_reset(&tree_pool);
+}
+
+/*
+ * name_index_rebuild
+ * ܣǰ洢ؽһɣ
+ * 
+ * ֵ1ʾɹ0ʾڴ治㣻ųļ¼player_store_excludedǼ
+ * ˼·ؽ׷ӵ顢һԪضʱ̣߳
+ *           ֱӽȫƽO(n log n)齨ͷ
+ */
+int name_index_rebuild(void) {
+    clear_hash();
+    sorted_count = 0;
+
+    int needed = NAME_INDEX_MIN_BUCKETS;
+    while (needed < player_store.count) {
+        needed *= 2;                            /* һȷͰ */
+    }
+    if (needed > hash_bucket_count && !resize_hash(needed)) return 0;
+    if (!reserve_sorted(player_store.count)) return 0;
+
+    for (int i = 0; i < player_store.count; i++) {
+        if (player_store_excluded(i)) {
+            continue;                           /* 𻵵ļ¼ûн */
+        }
+        const Player* player = &player_store.records[i];
+        NameIndexNode* node = (NameIndexNode*)record_pool_alloc(&node_pool);
+        if (node == NULL) return 0;
+        node->hash = hash_name(player->name);
+        node->handle = player_store_handle_at(i);
+        int pos = (int)(node->hash & (unsigned int)(hash_bucket_count - 1));
+        node->next = hash_buckets[pos];
+        hash_buckets[pos] = node;
+        hash_node_count++;
+
+        NameSortEntry* entry = &sorted_entries[sorted_count++];
+        memcpy(entry->name, player->name, sizeof(entry->name));
+        entry->name[sizeof(entry->name) - 1] = '\0';
+        entry->handle = node->handle;
+    }
+    sort_entries();                             /* Ԫؽ϶ʱ߳ */
+    
+    int failed = 0;
+    tree_root = build_tree(0, sorted_count, &failed);
+    free(sorted_entries);                       /* ֻؽʱʹ */
+    sorted_entries = NULL;
+    sorted_count = 0;
+    sorted_capacity = 0;
+    if (failed) {
+        clear_hash();                           /* ڴ治㣬²ȱ */
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * name_index_release
+ * ܣͷռõȫڴ
+ * 
+ */
+void name_index_release(void) {
+    clear_hash();
+    record_pool_release(&node_pool);
+    record_pool_release(&tree_pool);
+    free(hash_buckets);
+    free(sorted_entries);
+    hash_buckets = NULL;
+    hash_bucket_count = 0;
+    sorted_entries = NULL;
+    sorted_count = 0;
+    sorted_capacity = 0;
+}
@@ -0,0 +1,66 @@
+#ifndef NAME_INDEX_H
+#define NAME_INDEX_H
+
+#include "player_store.h"
+
+/*
+ * ģ
+ * 1. ϣӳ䣺 -> ȫͬԱȷO(1+ͬ)
+ * 2. ֽеƽ(AVL)֧ǰ׺ңO(log n + )
+ *    ǼעΪO(log n)ӻط־ʱƶ
+ * ȽϰֽڽУGBKUTF-8ȷǰ׺ƥ
+ */
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * name_index_insert
+ * ܣǼĶӦϵ
+ * name - Ա, handle - Ա
+ * ֵ1ʾɹ0ʾڴ治
+ */
+int name_index_insert(const char* name, PlayerHandle handle);
+
+/*
+ * name_index_remove
+ * ܣƳĶӦϵڼ¼޸֮ǰã
+ * name - Ǽʱʹõ, handle - Ա
+ * ֵ1ʾƳɹ0ʾδǼ
+ */
+int name_index_remove(const char* name, PlayerHandle handle);
+
+/*
+ * name_index_find_exact
+ * ܣnameȫͬȫԱ
+ * name - , results - , max_results - 
+ * ֵƥܴmax_resultsǰmax_resultsдresults
+ */
+int name_index_find_exact(const char* name, PlayerHandle* results, int max_results);
+
+/*
+ * name_index_find_prefix
+ * ܣprefixͷȫԱֽ
+ * prefix - ǰ׺, results - , max_results - 
+ * ֵƥܴmax_resultsǰmax_resultsдresults
+ */
+int name_index_find_prefix(const char* prefix, PlayerHandle* results, int max_results);
+
+/*
+ * name_index_rebuild
+ * ܣǰ洢ؽһֱӽƽ
+ * 
+ * ֵ1ʾɹ0ʾڴ治
+ */
+int name_index_rebuild(void);
+
+/*
+ * name_index_release
+ * ܣͷռõȫڴ
+ * 
+ */
+void name_index_release(void);
+
+#endif /* NAME_INDEX_H */
@@ -0,0 +1,70 @@
+#include <stdio.h>
+#include <windows.h>
+#include "parallel.h"
+
+/*
+ * ߳ڲ
+ */
+typedef struct ParallelJob {
+    ParallelTask task;
+    void* arg;
+} ParallelJob;
+
+/*
+ * job_main
+ * ܣ߳ڣִһ
+ */
+static DWORD WINAPI job_main(LPVOID param) {
+    ParallelJob* job = (ParallelJob*)param;
+    job->task(job->arg);
+    return 0;
+}
+
+/*
+ * parallel_worker_count
+ * ܣȷitemsӦʹõ߳
+ * items - , min_items - ÿ߳ٷֵ
+ * ֵ߳
+ */
+int parallel_worker_count(int items, int min_items) {
+    static int processors = 0;                   /* ״εʱȡ */
+    if (processors == 0) {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        processors = info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+    }
+    int workers = min_items > 0 ? items / min_items : 1;
+    if (workers > processors) workers = processors;
+    if (workers > PARALLEL_MAX_WORKERS) workers = PARALLEL_MAX_WORKERS;
+    return workers > 1 ? workers : 1;
+}
+
+/*
+ * parallel_run
+ * ܣִcountȫ󷵻
+ * task - , args - , arg_size - ÿֽ, count - 
+ */
+void parallel_run(ParallelTask task, void* args, size_t arg_size, int count) {
+    ParallelJob jobs[PARALLEL_MAX_WORKERS];
+    HANDLE threads[PARALLEL_MAX_WORKERS];
+    if (count > PARALLEL_MAX_WORKERS) {
+        count = PARALLEL_MAX_WORKERS;
+    }
+    for (int i = 1; i < count; i++) {            /* 0߳ */
+        jobs[i].task = task;
+        jobs[i].arg = (char*)args + (size_t)i * arg_size;
+        threads[i] = CreateThread(NULL, 0, job_main, &jobs[i], 0, NULL);
+        if (threads[i] == NULL) {
+            task(jobs[i].arg);                   /* ޷ִ̣߳ */
+        }
+    }
+    if (count > 0) {
+        task(args);
+    }
+    for (int i = 1; i < count; i++) {
+        if (threads[i] != NULL) {
+            WaitForSingleObject(threads[i], INFINITE);
+            CloseHandle(threads[i]);
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <stddef.h>
+
+/*
+ * ִģ
+ * һɵָ߳ͬʱִУȫ󷵻ء
+ * ڼشļؽ¼ȵʱ洦½
+ * СʱֻõԼ̡̣߳߳
+ */
+
+#define PARALLEL_MAX_WORKERS 16          /* ͬʱִе߳ */
+
+typedef void (*ParallelTask)(void* arg); /* argΪԼĲ */
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * parallel_worker_count
+ * ܣȷitemsӦʹõ߳
+ * items - , min_items - ÿ߳ٷֵ
+ * ֵ1PARALLEL_MAX_WORKERS֮䣬
+ */
+int parallel_worker_count(int items, int min_items);
+
+/*
+ * parallel_run
+ * ܣִcountȫ󷵻
+ * task - , args - ɵ, arg_size - ÿֽ,
+ *       count - PARALLEL_MAX_WORKERS
+ * ˵һڵִ߳У޷߳ʱڵִ߳Уͬ
+ */
+void parallel_run(ParallelTask task, void* args, size_t arg_size, int count);
+
+#endif /* PARALLEL_H */
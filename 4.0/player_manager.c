@@ -3,116 +3,380 @@
 #include <string.h>
 #include "data_struct.h"
 #include "file_ops.h"
+#include "player_store.h"
+#include "id_index.h"
+#include "id_file_index.h"
+#include "name_index.h"
+#include "team_pool.h"
+#include "team_index.h"
+#include "aggregate_index.h"
+#include "leaderboard.h"
+#include "wal.h"
+#include "dirty_tracker.h"
 #include "player_manager.h"
 
+/*
+ * index_player_stats / unindex_player_stats
+ * ܣǼǻעͳͳƻЧа񣩣߶¼ݱ仯
+ * ֵindex_player_stats1ʾɹ0ʾڴ治㣨ѵǼǵĲֻᱻ
+ */
+static int index_player_stats(const Player* player, PlayerHandle handle) {
+    if (!aggregate_index_insert(player, handle)) {
+        return 0;
+    }
+    if (!leaderboard_insert(player, handle)) {
+        aggregate_index_remove(player, handle); /* ͳƻ */
+        return 0;
+    }
+    return 1;
+}
+
+static void unindex_player_stats(const Player* player, PlayerHandle handle) {
+    aggregate_index_remove(player, handle);
+    leaderboard_remove(player, handle);
+}
+
+/*
+ * index_player
+ * ܣΪһѴ洢ļ¼Ǽȫ
+ * player - ¼ָ, handle - ¼
+ * ֵ1ʾɹ0ʾڴ治㣨ѵǼǵĲֻᱻ
+ */
+static int index_player(const Player* player, PlayerHandle handle) {
+    if (!id_index_insert(player->id_key, handle)) {
+        return 0;                               /* ѧǼʧ */
+    }
+    if (!name_index_insert(player->name, handle)) {
+        id_index_remove(player->id_key);        /* ѧ */
+        return 0;
+    }
+    if (!team_index_insert(player->team_id, handle)) {
+        id_index_remove(player->id_key);        /* ѧ */
+        name_index_remove(player->name, handle);
+        return 0;
+    }
+    if (!index_player_stats(player, handle)) {
+        id_index_remove(player->id_key);        /* ѧš */
+        name_index_remove(player->name, handle);
+        team_index_remove(handle);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * unindex_player
+ * ܣȫעһ¼ڼ¼޸Ļɾ֮ǰã
+ * player - ¼ָ, handle - ¼
+ */
+static void unindex_player(const Player* player, PlayerHandle handle) {
+    id_index_remove(player->id_key);
+    name_index_remove(player->name, handle);
+    team_index_remove(handle);
+    unindex_player_stats(player, handle);
+}
+
+/*
+ * replace_player
+ * ܣ֤¼¼滻洢еļ¼ͬͳ
+ * player - 洢еļ¼, updated - ݣѧűͬ
+ * ֵ1ʾɹ0ʾڴ治㣨ԭ¼δĶ
+ * ˼·ʧܵĵǼǰͳࡢӡ˳Уһʧʱ෴˳ɵĲ裻
+ *           ֻǰѾŻظڳλõԭͰԭᣬҪڴ棬˲ʧܣ
+ *           עʧܣȫǼǳɹ֮
+ */
+static int replace_player(Player* player, const Player* updated) {
+    PlayerHandle handle = player_store_handle_of(player);
+    int team_changed = updated->team_id != player->team_id;
+    int name_changed = strcmp(updated->name, player->name) != 0;
+    
+    /* һͳƻЧаעٵǼ */
+    unindex_player_stats(player, handle);
+    if (!index_player_stats(updated, handle)) {
+        index_player_stats(player, handle);     /* ڴ治㣬ָԭ */
+        return 0;
+    }
+    
+    /* ڶӱ仯ʱѾתӵĻ */
+    if (team_changed) {
+        team_index_remove(handle);
+        if (!team_index_insert(updated->team_id, handle)) {
+            team_index_insert(player->team_id, handle);  /* ڶŻԭ */
+            unindex_player_stats(updated, handle);       /* һ */
+            index_player_stats(player, handle);
+            return 0;
+        }
+    }
+    
+    /* 仯ʱǼ */
+    if (name_changed && !name_index_insert(updated->name, handle)) {
+        if (team_changed) {                     /* ڶ */
+            team_index_remove(handle);
+            team_index_insert(player->team_id, handle);
+        }
+        unindex_player_stats(updated, handle);  /* һ */
+        index_player_stats(player, handle);
+        return 0;
+    }
+    
+    /* ȫǼǳɹעдش洢 */
+    if (name_changed) {
+        name_index_remove(player->name, handle);
+    }
+    memcpy(player, updated, sizeof(Player));    /* дش洢 */
+    dirty_tracker_mark(handle);                 /* ʱ͵ظдü¼ */
+    return 1;
+}
+
+/*
+ * copy_text_field
+ * ܣн縴ֶַΣֽضϣʣֽ
+ */
+static void copy_text_field(char* dest, size_t dest_size, const char* src) {
+    memset(dest, 0, dest_size);
+    strncpy(dest, src, dest_size - 1);
+}
+
+static int pending_indexes = 0;                 /* Ƴٵ״βѯʱ(INDEX_*λ) */
+static int skipped_records = 0;                 /* ʱӱԽδǼǵļ¼ */
+static int journal_failed = 0;                  /* 1ʾиĶδܼԤд־δ */
+
+/*
+ * note_skipped
+ * ܣһӷؽʱļ¼
+ * skipped - ؽķֵ
+ * ֵ1ʾؽɹ0ʾڴ治
+ * ˵ͬһ¼ȡֵۼ
+ */
+static int note_skipped(int skipped) {
+    if (skipped > skipped_records) {
+        skipped_records = skipped;
+    }
+    return skipped >= 0;
+}
+
+/*
+ * rebuild_player_indexes
+ * ܣ洢ǰؽȫ
+ * 
+ * ֵ1ʾɹ0ʾڴ治
+ * ˵ʧʱֻһ룬ȫΪڣensure_player_indexes״ʹʱ
+ */
+int rebuild_player_indexes(void) {
+    skipped_records = 0;
+    if (!note_skipped(check_mapped_records()) ||    /* ӳļ¼Ⱥ˶ԣϸĲǼ */
+        !id_index_rebuild() ||                  /* ѧŹϣ */
+        !name_index_rebuild() ||                /*  */
+        !note_skipped(team_index_rebuild()) ||        /* ӻ */
+        !note_skipped(aggregate_index_rebuild()) ||   /* ͳƻ */
+        !note_skipped(leaderboard_rebuild())) {       /* Ча */
+        defer_player_indexes();                 /* ѽһ */
+        return 0;
+    }
+    pending_indexes = 0;
+    return 1;
+}
+
+/*
+ * defer_player_indexes
+ * ܣȫѹڣƳٵ״βѯʱٷֱؽ
+ * 
+ * ˵ֻӳģʽʹãʱطȫ¼ȫؽڴ治ʱҲԺ
+ */
+void defer_player_indexes(void) {
+    pending_indexes = INDEX_ALL;
+    skipped_records = 0;
+}
+
+/*
+ * ensure_player_indexes
+ * ܣָ֤洢һ£Ƴٵڴʱ
+ * which - ҪINDEX_*λ룩Ϊ0ʱֻ˶ӳļ¼
+ * ֵ1ʾã0ʾڴ治
+ * ˼·ֱѧŲҲصȴ
+ *           ӳģʽ½κ֮ǰȺ˶ȫ¼ֻ˶һΣ𻵵ļ¼Ǽ
+ */
+int ensure_player_indexes(int which) {
+    int needed = pending_indexes & which;       /* Ҫδ */
+    if (!note_skipped(check_mapped_records())) return 0;
+    if ((needed & INDEX_ID) && !id_index_rebuild()) return 0;
+    if ((needed & INDEX_NAME) && !name_index_rebuild()) return 0;
+    if ((needed & INDEX_TEAM) && !note_skipped(team_index_rebuild())) return 0;
+    if ((needed & INDEX_AGGREGATE) && !note_skipped(aggregate_index_rebuild())) return 0;
+    if ((needed & INDEX_LEADERBOARD) && !note_skipped(leaderboard_rebuild())) return 0;
+    pending_indexes &= ~needed;
+    return 1;
+}
+
+/*
+ * skipped_player_records
+ * ܣȡýʱ¼𻵻ӱԽδǼǵļ¼
+ * 
+ * ֵ¼Щ¼κУѯͳа񶼲
+ * ˵ֻֻӳģʽ֣ӳʱ¼ͨʱ¼ѱ
+ *       𻵵ļ¼corrupt_record_report
+ */
+int skipped_player_records(void) {
+    return skipped_records;
+}
+
+/*
+ * journal_write_failed
+ * ܣжϴβѯǷиĶδܼԤд־
+ * 
+ * ֵ1ʾУ0ʾû
+ * ˵ĶЧֻδ־ûɵ߾дļ
+ */
+int journal_write_failed(void) {
+    int failed = journal_failed;
+    journal_failed = 0;
+    return failed;
+}
+
 /*
  * add_new_player
- * ܣԱԱ¼ͷ巨
+ * ܣԱ洢Ա¼׷ӵĩβ
  * id-ѧ, name-, team-, position-λ, height-, weight-, jersey-º
- * ֵɹ½ڵָ룬ʧܷNULL
- * 㷨Ȳغ룬ʱ临ӶO(n)
+ * ֵɹ¼¼ָ룬ʧܷNULL
+ * 㷨ȾѧŹϣ׷ӣʱ临ӶO(1)
+ * ע⣺صָһɾ֮ǰЧڱʹþ
  */
 Player* add_new_player(const char* id, const char* name, const char* team, 
                       const char* position, int height, int weight, int jersey) {
-    /* һزȷѧΨһ */
-    Player* current = player_list;              /* ͷڵ㿪ʼ */
-    while (current != NULL) {                   /*  */
-        if (strcmp(current->id, id) == 0) {     /* ȽѧǷͬ */
-            return NULL;                        /* ѧظʧ */
-        }
-        current = current->next;                /* ƶһڵ */
+    if (player_store.read_only) {
+        return NULL;                            /* ֻģʽ */
     }
     
-    /* ڶڴ䣬½ڵ */
-    Player* new_player = (Player*)malloc(sizeof(Player));
-    if (new_player == NULL) {                   /* ڴʧܼ */
-        return NULL;                            /* NULLʾʧ */
+    /* һѧŲأȷѧΨһ */
+    uint64_t key;                               /* ѧ */
+    if (!pack_player_id(id, &key) || !ensure_player_indexes(INDEX_ALL)) {
+        return NULL;                            /* ѧŲ12λֻ޷ */
+    }
+    if (id_index_find(key) != INVALID_PLAYER_HANDLE) {  /* ѧѴ */
+        return NULL;                            /* ѧظʧ */
     }
     
-    /* 䣬Ʋ½ڵ */
-    strcpy(new_player->id, id);                 /* ѧַ */
-    strcpy(new_player->name, name);             /* ַ */
-    strcpy(new_player->team, team);             /* ַ */
-    strcpy(new_player->position, position);     /* λַ */
-    new_player->height = height;                /* ֵֵ */
-    new_player->weight = weight;                /* ֵֵ */
-    new_player->jersey = jersey;                /* ֵº */
+    /* ڶ䣬ջװ¼¼ */
+    Player new_player;
+    memset(&new_player, 0, sizeof(Player));     /* 㣬ֽ */
+    new_player.id_key = key;                    /* ںȫȽ */
+    copy_text_field(new_player.id, sizeof(new_player.id), id);
+    copy_text_field(new_player.name, sizeof(new_player.name), name);
+    new_player.position = (uint8_t)position_from_name(position);   /* Ƿλ֤ */
+    new_player.height = height;                 /* ֵֵ */
+    new_player.weight = weight;                 /* ֵֵ */
+    new_player.jersey = jersey;                 /* ֵº */
     
-    /* Ĳ֤ȷϷ */
-    if (!validate_player_data(new_player)) {    /* ֤ */
-        free(new_player);                       /* ֤ʧͷڴ */
+    /* ֤ȷϷԣ֤ͨŵǼ */
+    if (!validate_player_fields(&new_player)) { /* ֤ */
         return NULL;                            /* NULLʾʧ */
     }
+    int team_id = team_pool_intern(team);       /* פ¼ֻ */
+    if (team_id < 0) {
+        return NULL;                            /* ڴ治ӱþ */
+    }
+    new_player.team_id = (uint16_t)team_id;
     
-    /* 岽룬ͷ巨Ч */
-    new_player->next = player_list;             /* ½ڵָԭͷڵ */
-    player_list = new_player;                   /* ͷڵΪ½ڵ */
-    
-    return new_player;                          /* ½ڵָ */
+    /* Ĳ׷ӵ洢ĩβǼ */
+    Player* stored = player_store_append(&new_player);
+    if (stored == NULL) {                       /* ڴ治 */
+        return NULL;
+    }
+    PlayerHandle handle = player_store_handle_of(stored);
+    if (!index_player(stored, handle)) {        /* ʧܣ׷ */
+        player_store_remove(handle);
+        return NULL;
+    }
+    dirty_tracker_mark(handle);                 /* ʱ׷ӵļĩβ */
+    if (!wal_log_put(stored)) {                 /* Ԥд־ */
+        journal_failed = 1;
+    }
+    return stored;                              /* ¼¼ָ */
 }
 
 /*
  * search_player_by_id
- * ܣͨѧвԱ
+ * ܣͨѧڴ洢вԱϣ
  * id - Ҫҵѧַ
  * ֵҵԱָ룬δҵNULL
- * ʱ临ӶȣO(n)nΪ
+ * ʱ临ӶȣO(1)ӳģʽڴδʱĲѧļO(log n)ֻһҳ
+ *           ҵļ¼ͬ˶Уֵӱţϸʱڴǰ˶ȫ¼
  */
 Player* search_player_by_id(const char* id) {
-    Player* current = player_list;              /* ͷڵ㿪ʼ */
-    while (current != NULL) {                   /*  */
-        if (strcmp(current->id, id) == 0) {     /* ַȽѧ */
-            return current;                     /* ҵƥ䣬ָ */
+    uint64_t key;                               /* ѧ */
+    if (!pack_player_id(id, &key)) {
+        return NULL;                            /* ǷѧűȻ */
+    }
+    int slot;                                   /* ļĲλ */
+    if ((pending_indexes & INDEX_ID) && id_file_index_find(key, &slot)) {
+        Player* found = slot >= 0 ? player_store_get(player_store_handle_at(slot)) : NULL;
+        if (slot < 0 || (found != NULL && found->id_key == key && mapped_record_intact(slot) &&
+                         found->team_id < team_pool_count())) {
+            return found;                       /* ֻ˶ҵһ */
         }
-        current = current->next;                /* ƶһڵ */
+        id_file_index_close();                  /* ¼¼ϸ񣬴˺ڴ */
+    }
+    if (!ensure_player_indexes(INDEX_ID)) {
+        return NULL;
     }
-    return NULL;                                /* δҵ */
+    return player_store_get(id_index_find(key));   /* ЧʱNULL */
 }
 
 /*
  * search_player_by_name
- * ܣͨвԱȷƥ䣩
+ * ܣͨԱȷƥ䣬صһλͬԱ
  * name - Ҫҵַ
  * ֵҵԱָ룬δҵNULL
- * ע˺Ϊȷƥ䣬չΪģ
+ * עͬԱȫгʱʹsearch_players_by_name
  */
 Player* search_player_by_name(const char* name) {
-    Player* current = player_list;              /* ͷڵ㿪ʼ */
-    while (current != NULL) {                   /*  */
-        if (strcmp(current->name, name) == 0) { /* ַȽ */
-            return current;                     /* ҵƥ䣬ָ */
-        }
-        current = current->next;                /* ƶһڵ */
+    PlayerHandle handle;                        /* ֻȡһ */
+    if (!ensure_player_indexes(INDEX_NAME) || name_index_find_exact(name, &handle, 1) == 0) {
+        return NULL;                            /* ͬԱ */
     }
-    return NULL;                                /* δҵ */
+    return player_store_get(handle);
+}
+
+/*
+ * search_players_by_name
+ * ܣͨȫͬԱȷƥ䣬ϣ
+ * name - , results - , max_results - 
+ * ֵͬԱܴmax_results
+ */
+int search_players_by_name(const char* name, PlayerHandle* results, int max_results) {
+    if (!ensure_player_indexes(INDEX_NAME)) return 0;
+    return name_index_find_exact(name, results, max_results);
+}
+
+/*
+ * search_players_by_name_prefix
+ * ܣprefixͷȫԱ
+ * prefix - ǰ׺, results - , max_results - 
+ * ֵƥܴmax_results
+ */
+int search_players_by_name_prefix(const char* prefix, PlayerHandle* results, int max_results) {
+    if (!ensure_player_indexes(INDEX_NAME)) return 0;
+    return name_index_find_prefix(prefix, results, max_results);
 }
 
 /*
  * delete_player_by_id
- * ܣͨѧɾеԱڵ
+ * ܣͨѧɾ洢еԱ¼
  * id - ҪɾԱѧ
  * ֵ1ʾɾɹ0ʾδҵ
- * 㷨ͷڵɾмڵɾβڵɾ
+ * 㷨ϣλɴ洢ģִswap-removeO(1)
  */
 int delete_player_by_id(const char* id) {
-    Player* current = player_list;              /* ǰڵָ */
-    Player* previous = NULL;                    /* ǰڵָ */
-    
-    while (current != NULL) {                   /*  */
-        if (strcmp(current->id, id) == 0) {     /* ҵƥѧ */
-            if (previous == NULL) {             /* 1ɾͷڵ */
-                player_list = current->next;    /* ͷڵָ */
-            } else {                            /* 2ɾмβڵ */
-                previous->next = current->next; /* ǰڵǰڵ */
-            }
-            free(current);                      /* ͷŵǰڵڴ */
-            return 1;                           /* ɾɹ־ */
-        }
-        previous = current;                     /* ǰڵָ */
-        current = current->next;                /* ƶһڵ */
+    uint64_t key;                               /* ѧ */
+    if (!pack_player_id(id, &key) || !delete_player_by_key(key)) {
+        return 0;                               /* Ƿѧšδҵֻģʽ */
     }
-    return 0;                                   /* δҵҪɾĽڵ */
+    if (!wal_log_delete(key)) {                 /* Ԥд־ */
+        journal_failed = 1;
+    }
+    return 1;
 }
+
 /*
  * update_player_by_id
  * ܣͨѧ޸ԱϢ
@@ -120,52 +384,108 @@ int delete_player_by_id(const char* id) {
  *        field - Ҫ޸ĵֶΣ1-2-ӣ3-λã4-ߣ5-أ6-ºţ
  *        new_value - ֵַ
  * ֵ1ʾ޸ĳɹ0ʾδҵ޸ʧ
+ * ˼·ڸ޸Ĳ֤֤ͨͬдأʧʱԭ¼
  */
 int update_player_by_id(const char* id, int field, void* new_value) {
     Player* player = search_player_by_id(id);   /* Ա */
-    if (player == NULL) {
-        return 0;                               /* Ա */
+    if (player == NULL || new_value == NULL || player_store.read_only ||
+        !ensure_player_indexes(INDEX_ALL)) {
+        return 0;                               /* ԱڡֵΪաֻģʽ޷ */
     }
     
+    Player updated;                             /* ޸ĺļ¼ */
+    memcpy(&updated, player, sizeof(Player));
+    
+    const char* new_team = NULL;                /* ƣ֤ͨŵǼ */
+    
     switch (field) {
         case 1: /* ޸ */
-            if (new_value != NULL) {
-                strcpy(player->name, (char*)new_value);
-            }
+            copy_text_field(updated.name, sizeof(updated.name), (const char*)new_value);
             break;
-        case 2: /* ޸ */
-            if (new_value != NULL) {
-                strcpy(player->team, (char*)new_value);
-            }
+        case 2: /* ޸ӣפֻȽϱ */
+            new_team = (const char*)new_value;
             break;
-        case 3: /* ޸λ */
-            if (new_value != NULL) {
-                strcpy(player->position, (char*)new_value);
-            }
+        case 3: /* ޸λãıתΪλñ */
+            updated.position = (uint8_t)position_from_name((const char*)new_value);
             break;
         case 4: /* ޸ */
-            if (new_value != NULL) {
-                player->height = *(int*)new_value;
-            }
+            updated.height = *(int*)new_value;
             break;
         case 5: /* ޸ */
-            if (new_value != NULL) {
-                player->weight = *(int*)new_value;
-            }
+            updated.weight = *(int*)new_value;
             break;
         case 6: /* ޸º */
-            if (new_value != NULL) {
-                player->jersey = *(int*)new_value;
-            }
+            updated.jersey = *(int*)new_value;
             break;
         default:
             return 0;                           /* Чֶ */
     }
     
-    /* ֤޸ĺ */
-    if (validate_player_data(player)) {
-        return 1;                               /* ޸ĳɹ */
-    } else {
+    /* ֤޸ĺݣϷʱԭ¼ֲ */
+    if (!validate_player_fields(&updated)) {
         return 0;                               /* ݲϷ޸ʧ */
     }
+    if (new_team != NULL) {
+        int team_id = team_pool_intern(new_team);
+        if (team_id < 0) {
+            return 0;                           /* ڴ治ӱþ */
+        }
+        updated.team_id = (uint16_t)team_id;
+    }
+    
+    if (!replace_player(player, &updated)) {
+        return 0;                               /* ڴ治㣬ԭ¼ */
+    }
+    if (!wal_log_put(player)) {                 /* Ԥд־ */
+        journal_failed = 1;
+    }
+    return 1;                                   /* ޸ĳɹ */
+}
+
+/*
+ * put_player_record
+ * ܣѧдһ¼ѧѴʱ滻
+ * record - Ա¼ӱפеǼǣ
+ * ֵ1ʾɹ0ʾݲϷֻģʽڴ治
+ * ˵ֻȡڼ¼ظִЧͬطԤд־д־
+ */
+int put_player_record(const Player* record) {
+    if (player_store.read_only || !validate_player_data(record) || !ensure_player_indexes(INDEX_ALL)) {
+        return 0;
+    }
+    Player* existing = player_store_get(id_index_find(record->id_key));
+    if (existing != NULL) {
+        return replace_player(existing, record);   /* 滻 */
+    }
+    Player* stored = player_store_append(record);
+    if (stored == NULL) {
+        return 0;                               /* ڴ治 */
+    }
+    PlayerHandle handle = player_store_handle_of(stored);
+    if (!index_player(stored, handle)) {        /* ʧܣ׷ */
+        player_store_remove(handle);
+        return 0;
+    }
+    dirty_tracker_mark(handle);
+    return 1;
+}
+
+/*
+ * delete_player_by_key
+ * ܣѧɾԱ¼
+ * key - ѧ
+ * ֵ1ʾɾɹ0ʾδҵֻģʽ
+ * ˵طԤд־д־
+ */
+int delete_player_by_key(uint64_t key) {
+    if (player_store.read_only || !ensure_player_indexes(INDEX_ALL)) {
+        return 0;                               /* ֻģʽɾ޷ */
+    }
+    PlayerHandle handle = id_index_find(key);   /* Ҿ */
+    if (handle == INVALID_PLAYER_HANDLE) {
+        return 0;                               /* δҵҪɾļ¼ */
+    }
+    unindex_player(player_store_get(handle), handle);   /* ע */
+    dirty_tracker_remove(handle);               /* ʱԭλдΪղ */
+    return player_store_remove(handle);         /* ɾ¼ */
 }
@@ -2,6 +2,15 @@
 #define PLAYER_MANAGER_H
 
 #include "data_struct.h"
+#include "player_store.h"
+
+/* ʶensure_player_indexes轨Ƴٵ */
+#define INDEX_ID 1                       /* ѧŹϣ */
+#define INDEX_NAME 2                     /*  */
+#define INDEX_TEAM 4                     /* ӻ */
+#define INDEX_AGGREGATE 8                /* ͳƻ */
+#define INDEX_LEADERBOARD 16             /* Ча */
+#define INDEX_ALL (INDEX_ID | INDEX_NAME | INDEX_TEAM | INDEX_AGGREGATE | INDEX_LEADERBOARD)   /* ȫɾǰ뱸 */
 
 /*
  * 
@@ -10,16 +19,17 @@
 
 /*
  * add_new_player
- * ܣԱԱ¼ͷ巨
+ * ܣԱ洢Ա¼׷ӵĩβ
  * id-ѧ, name-, team-, position-λ, height-, weight-, jersey-º
- * ֵɹ½ڵָ룬ʧܷNULL
+ * ֵɹ¼¼ָ룬ʧܷNULL
+ * ע⣺صָһɾ֮ǰЧ
  */
 Player* add_new_player(const char* id, const char* name, const char* team, 
                       const char* position, int height, int weight, int jersey);
 
 /*
  * search_player_by_id
- * ܣͨѧвԱ
+ * ܣͨѧڴ洢вԱϣ
  * id - Ҫҵѧַ
  * ֵҵԱָ룬δҵNULL
  */
@@ -27,18 +37,101 @@ Player* search_player_by_id(const char* id);
 
 /*
  * search_player_by_name
- * ܣͨвԱȷƥ䣩
+ * ܣͨڴ洢вԱȷƥ䣬صһλͬԱ
  * name - Ҫҵַ
  * ֵҵԱָ룬δҵNULL
  */
 Player* search_player_by_name(const char* name);
 
+/*
+ * search_players_by_name
+ * ܣͨȫͬԱȷƥ䣩
+ * name - , results - , max_results - 
+ * ֵͬԱܴmax_resultsǰmax_resultsдresults
+ */
+int search_players_by_name(const char* name, PlayerHandle* results, int max_results);
+
+/*
+ * search_players_by_name_prefix
+ * ܣprefixͷȫԱ
+ * prefix - ǰ׺, results - , max_results - 
+ * ֵƥܴmax_results
+ */
+int search_players_by_name_prefix(const char* prefix, PlayerHandle* results, int max_results);
+
 /*
  * delete_player_by_id
- * ܣͨѧɾеԱڵ
+ * ܣͨѧɾ洢еԱ¼
  * id - ҪɾԱѧ
  * ֵ1ʾɾɹ0ʾδҵ
  */
 int delete_player_by_id(const char* id);
 
+/*
+ * update_player_by_id
+ * ܣͨѧ޸ԱϢ޸ĺݲϷʱԭ¼ֲ
+ * id - Ҫ޸ĵԱѧ
+ *        field - Ҫ޸ĵֶΣ1-2-ӣ3-λã4-ߣ5-أ6-ºţ
+ *        new_value - ֵַ
+ * ֵ1ʾ޸ĳɹ0ʾδҵ޸ʧ
+ */
+int update_player_by_id(const char* id, int field, void* new_value);
+
+/*
+ * put_player_record
+ * ܣѧдһ¼ѧѴʱ滻
+ * record - Ա¼ӱפеǼǣ
+ * ֵ1ʾɹ0ʾݲϷֻģʽڴ治
+ * ˵ظִЧͬطԤд־д־
+ */
+int put_player_record(const Player* record);
+
+/*
+ * delete_player_by_key
+ * ܣѧɾԱ¼
+ * key - ѧ
+ * ֵ1ʾɾɹ0ʾδҵֻģʽ
+ * ˵طԤд־д־
+ */
+int delete_player_by_key(uint64_t key);
+
+/*
+ * rebuild_player_indexes
+ * ܣ洢ǰؽȫغã
+ * 
+ * ֵ1ʾɹ0ʾڴ治㣨ȫΪڣ״ʹʱԣ
+ */
+int rebuild_player_indexes(void);
+
+/*
+ * defer_player_indexes
+ * ܣȫѹڣƳٵ״βѯʱٷֱؽ
+ * 
+ */
+void defer_player_indexes(void);
+
+/*
+ * ensure_player_indexes
+ * ܣָ֤洢һ£Ƴٵڴʱ
+ * which - ҪINDEX_*λ룩Ϊ0ʱֻ˶ӳļ¼check_mapped_records
+ * ֵ1ʾã0ʾڴ治
+ */
+int ensure_player_indexes(int which);
+
+/*
+ * skipped_player_records
+ * ܣȡýʱ¼𻵻ӱԽδǼǵļ¼
+ * 
+ * ֵ¼Щ¼κУֻӳģʽŻ֣𻵵ļcorrupt_record_report
+ */
+int skipped_player_records(void);
+
+/*
+ * journal_write_failed
+ * ܣжϴβѯǷиĶδܼԤд־
+ * 
+ * ֵ1ʾУĶֻڴУдļܳ־û0ʾû
+ */
+int journal_write_failed(void);
+
 #endif /* PLAYER_MANAGER_H */
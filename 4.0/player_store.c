@@ -0,0 +1,254 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "data_struct.h"
+#include "player_store.h"
+
+/* ȫԱ洢 */
+PlayerStore player_store = { NULL, NULL, NULL, 0, 0, 0, -1, 0, NULL };
+
+#define STORE_INITIAL_CAPACITY 16        /* ״ηļ¼ */
+
+/*
+ * player_store_reserve
+ * ܣԤmin_capacity¼Ĵ洢ռ
+ * min_capacity - ҪС
+ * ֵ1ʾɹ0ʾڴ治
+ * ˼·ͬݣ̯O(1)
+ */
+int player_store_reserve(int min_capacity) {
+    if (player_store.read_only) {
+        return 0;                                /* ֻģʽ */
+    }
+    if (min_capacity <= player_store.capacity) {
+        return 1;                                /* 㹻 */
+    }
+
+    int new_capacity = player_store.capacity > 0 ? player_store.capacity : STORE_INITIAL_CAPACITY;
+    while (new_capacity < min_capacity) {        /* ֱ */
+        new_capacity *= 2;
+    }
+
+    /* ݣκһʧʱѳɹȻЧֲ */
+    Player* records = (Player*)realloc(player_store.records,
+                                       (size_t)new_capacity * sizeof(Player));
+    if (records == NULL) return 0;
+    player_store.records = records;
+
+    PlayerHandle* slot_handle = (PlayerHandle*)realloc(player_store.slot_handle,
+                                       (size_t)new_capacity * sizeof(PlayerHandle));
+    if (slot_handle == NULL) return 0;
+    player_store.slot_handle = slot_handle;
+
+    int* handle_slot = (int*)realloc(player_store.handle_slot,
+                                     (size_t)new_capacity * sizeof(int));
+    if (handle_slot == NULL) return 0;
+    player_store.handle_slot = handle_slot;
+
+    player_store.capacity = new_capacity;        /* ȫɹ */
+    return 1;
+}
+
+/*
+ * player_store_append
+ * ܣһ¼׷ӵĩβΪ
+ * record - ƵԱ¼
+ * ֵɹش洢еļ¼ָ룬ڴ治㷵NULL
+ * 䣺ȸɾ¼ͷŵľ¾
+ */
+Player* player_store_append(const Player* record) {
+    if (!player_store_reserve(player_store.count + 1)) {
+        return NULL;                             /* ʧ */
+    }
+
+    PlayerHandle handle;
+    if (player_store.free_handle >= 0) {         /* ÿо */
+        handle = player_store.free_handle;
+        player_store.free_handle = -player_store.handle_slot[handle] - 2;
+    } else {                                     /* ¾ */
+        handle = player_store.handle_count++;
+    }
+
+    int slot = player_store.count++;             /* ¼¼ĩβλ */
+    memcpy(&player_store.records[slot], record, sizeof(Player));
+    player_store.slot_handle[slot] = handle;     /* ˫ӳ */
+    player_store.handle_slot[handle] = slot;
+
+    return &player_store.records[slot];
+}
+
+/*
+ * player_store_fill
+ * ܣǼǵֱдǰcountλļ¼Ϊ
+ * count - ¼Ԥ
+ * ˵洢Ϊգգλ˳䣬׷ӵĽͬ
+ */
+void player_store_fill(int count) {
+    if (player_store.read_only || player_store.count != 0 || count > player_store.capacity) {
+        return;                                  /* ֻпյĿд洢Ǽ */
+    }
+    for (int slot = 0; slot < count; slot++) {
+        player_store.slot_handle[slot] = slot;
+        player_store.handle_slot[slot] = slot;
+    }
+    player_store.count = count;
+    player_store.handle_count = count;
+    player_store.free_handle = -1;
+}
+
+/*
+ * player_store_get
+ * ܣͨȡü¼ָ
+ * handle - Ա
+ * ֵ¼ָ룬ЧNULL
+ */
+Player* player_store_get(PlayerHandle handle) {
+    if (player_store.read_only) {                /* ֻģʽλ */
+        return handle >= 0 && handle < player_store.count ? &player_store.records[handle] : NULL;
+    }
+    if (handle < 0 || handle >= player_store.handle_count) {
+        return NULL;                             /* Խ */
+    }
+    int slot = player_store.handle_slot[handle];
+    if (slot < 0) {
+        return NULL;                             /* ͷ */
+    }
+    return &player_store.records[slot];
+}
+
+/*
+ * player_store_handle_of
+ * ܣȡô洢ĳ¼Ӧľ
+ * player - ָ洢ڲļ¼ָ
+ * ֵӦָ벻ڴ洢ʱINVALID_PLAYER_HANDLE
+ */
+PlayerHandle player_store_handle_of(const Player* player) {
+    if (player == NULL || player_store.count == 0) {
+        return INVALID_PLAYER_HANDLE;
+    }
+    if (player < player_store.records || player >= player_store.records + player_store.count) {
+        return INVALID_PLAYER_HANDLE;            /* ڴ洢 */
+    }
+    if (player_store.read_only) {
+        return (PlayerHandle)(player - player_store.records);   /* ֻģʽλ */
+    }
+    return player_store.slot_handle[player - player_store.records];
+}
+
+/*
+ * player_store_handle_at
+ * ܣȡòλϼ¼ľ˳ʱǼ
+ * slot - λ±꣬0count-1
+ * ֵӦ
+ */
+PlayerHandle player_store_handle_at(int slot) {
+    return player_store.read_only ? (PlayerHandle)slot : player_store.slot_handle[slot];
+}
+
+/*
+ * player_store_remove
+ * ܣɾӦļ¼ĩβ¼ճĲλ
+ * handle - ҪɾԱ
+ * ֵ1ʾɾɹ0ʾЧ
+ * 㷨swap-removeO(1)ɾʼձֽ
+ */
+int player_store_remove(PlayerHandle handle) {
+    if (player_store.read_only || player_store_get(handle) == NULL) {
+        return 0;                                /* ֻģʽЧ */
+    }
+
+    int slot = player_store.handle_slot[handle]; /* ɾ¼ڲλ */
+    int last = player_store.count - 1;           /* ĩβλ */
+
+    if (slot != last) {                          /* ĩβ¼λ */
+        PlayerHandle moved = player_store.slot_handle[last];
+        memcpy(&player_store.records[slot], &player_store.records[last], sizeof(Player));
+        player_store.slot_handle[slot] = moved;
+        player_store.handle_slot[moved] = slot;
+    }
+    player_store.count--;
+
+    /* Ϊ -(һо + 2) */
+    player_store.handle_slot[handle] = -player_store.free_handle - 2;
+    player_store.free_handle = handle;
+    return 1;
+}
+
+/*
+ * player_store_clear
+ * ܣм¼;ѷڴ湩¼ʹ
+ * 
+ */
+void player_store_clear(void) {
+    player_store.count = 0;
+    player_store.handle_count = 0;
+    player_store.free_handle = -1;
+}
+
+/*
+ * player_store_attach
+ * ܣͷڴ棬Ϊֱʹⲿֻ¼飨ֻģʽ
+ * records - ⲿ¼, count - ¼
+ * ˵ⲿplayer_store_detach֮ǰһֱЧ
+ *       ֻģʽӳλһһӦ
+ */
+void player_store_attach(const Player* records, int count) {
+    player_store_release();
+    player_store.records = (Player*)records;     /* ֻʣɾӿھܾ */
+    player_store.count = count;
+    player_store.handle_count = count;
+    player_store.read_only = 1;
+}
+
+/*
+ * player_store_detach
+ * ܣⲿ¼Ĺ洢ָΪյĿд״̬
+ * 
+ */
+void player_store_detach(void) {
+    if (!player_store.read_only) {
+        return;                                  /* δֻģʽ */
+    }
+    player_store.records = NULL;                 /* ⲿͷ */
+    player_store.excluded = NULL;
+    player_store.read_only = 0;
+    player_store_clear();
+}
+
+/*
+ * player_store_exclude
+ * ܣֻģʽòǼĲλ𻵵ļ¼
+ * marks - ÿλһֽڣ0ʾųNULLʾȫǼ
+ */
+void player_store_exclude(const unsigned char* marks) {
+    if (player_store.read_only) {
+        player_store.excluded = marks;
+    }
+}
+
+/*
+ * player_store_excluded
+ * ܣжϲλϵļ¼Ƿų֮
+ * slot - λ±꣬0count-1
+ * ֵ1ʾų0ʾǼ
+ */
+int player_store_excluded(int slot) {
+    return player_store.excluded != NULL && player_store.excluded[slot] != 0;
+}
+
+/*
+ * player_store_release
+ * ܣմ洢ͷȫڴ
+ * 
+ */
+void player_store_release(void) {
+    player_store_detach();                       /* ֻģʽ²ͷⲿ */
+    free(player_store.records);
+    free(player_store.slot_handle);
+    free(player_store.handle_slot);
+    player_store.records = NULL;
+    player_store.slot_handle = NULL;
+    player_store.handle_slot = NULL;
+    player_store.capacity = 0;
+    player_store_clear();
+}
@@ -0,0 +1,140 @@
+#ifndef PLAYER_STORE_H
+#define PLAYER_STORE_H
+
+#include "data_struct.h"
+
+/*
+ * Ա洢ģ
+ * Ա¼һУʱΪڴ
+ * ɾ"ĩβ"ʽswap-removeƶ¼
+ * (PlayerHandle)ڼ¼ڱֲ䣬ɰȫڱ棻
+ * ¼ָ(Player*)ֻһɾ֮ǰЧ
+ * ֻģʽ¼ֱָⲿڴ棨ļӳ䣩λ±꣬ɾ
+ */
+
+typedef int PlayerHandle;                /* Աȶ */
+
+#define INVALID_PLAYER_HANDLE (-1)       /* Ч */
+
+typedef struct PlayerStore {
+    Player* records;             /* Ա¼飬±꼴λ */
+    PlayerHandle* slot_handle;   /* λ -> ӳ */
+    int* handle_slot;            /*  -> λӳֵʾо */
+    int count;                   /* ǰЧ¼ */
+    int capacity;                /* ѷ */
+    int handle_count;            /* ùľˮλ */
+    int free_handle;             /* оͷ-1ʾ޿о */
+    int read_only;               /* 1ʾ¼Ϊⲿֻڴ */
+    const unsigned char* excluded;   /* ֻģʽ²ǼĲλǣ0NULLʾȫǼ */
+} PlayerStore;
+
+/* ȫԱ洢 */
+extern PlayerStore player_store;
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * player_store_reserve
+ * ܣԤmin_capacity¼Ĵ洢ռ
+ * min_capacity - ҪС
+ * ֵ1ʾɹ0ʾڴ治
+ */
+int player_store_reserve(int min_capacity);
+
+/*
+ * player_store_append
+ * ܣһ¼׷ӵĩβΪ
+ * record - ƵԱ¼
+ * ֵɹش洢еļ¼ָ룬ڴ治㷵NULL
+ */
+Player* player_store_append(const Player* record);
+
+/*
+ * player_store_fill
+ * ܣǼǵֱдǰcountλļ¼Ϊ
+ * count - ¼Ԥ
+ * ˵ֻմ洢أ߳̿ȸд뻥صĲλһεǼ
+ */
+void player_store_fill(int count);
+
+/*
+ * player_store_get
+ * ܣͨȡü¼ָ
+ * handle - Ա
+ * ֵ¼ָ룬ЧNULL
+ */
+Player* player_store_get(PlayerHandle handle);
+
+/*
+ * player_store_handle_of
+ * ܣȡô洢ĳ¼Ӧľ
+ * player - ָ洢ڲļ¼ָ
+ * ֵӦָ벻ڴ洢ʱINVALID_PLAYER_HANDLE
+ */
+PlayerHandle player_store_handle_of(const Player* player);
+
+/*
+ * player_store_handle_at
+ * ܣȡòλϼ¼ľ˳ʱǼ
+ * slot - λ±꣬0count-1
+ * ֵӦ
+ */
+PlayerHandle player_store_handle_at(int slot);
+
+/*
+ * player_store_remove
+ * ܣɾӦļ¼ĩβ¼ճĲλ
+ * handle - ҪɾԱ
+ * ֵ1ʾɾɹ0ʾЧ
+ */
+int player_store_remove(PlayerHandle handle);
+
+/*
+ * player_store_clear
+ * ܣм¼;ѷڴ湩¼ʹ
+ * 
+ */
+void player_store_clear(void);
+
+/*
+ * player_store_attach
+ * ܣͷڴ棬Ϊֱʹⲿֻ¼飨ֻģʽ
+ * records - ⲿ¼, count - ¼
+ * ˵ⲿplayer_store_detach֮ǰһֱЧ
+ */
+void player_store_attach(const Player* records, int count);
+
+/*
+ * player_store_detach
+ * ܣⲿ¼Ĺ洢ָΪյĿд״̬
+ * 
+ */
+void player_store_detach(void);
+
+/*
+ * player_store_exclude
+ * ܣֻģʽòǼĲλ𻵵ļ¼
+ * marks - ÿλһֽڣ0ʾųNULLʾȫǼ
+ * ˵ɵУplayer_store_detach֮ǰһֱЧ
+ */
+void player_store_exclude(const unsigned char* marks);
+
+/*
+ * player_store_excluded
+ * ܣжϲλϵļ¼Ƿų֮
+ * slot - λ±꣬0count-1
+ * ֵ1ʾų0ʾǼǣдģʽ0
+ */
+int player_store_excluded(int slot);
+
+/*
+ * player_store_release
+ * ܣմ洢ͷȫڴ
+ * 
+ */
+void player_store_release(void);
+
+#endif /* PLAYER_STORE_H */
@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "record_pool.h"
+
+/*
+ * record_pool_alloc
+ * ܣӶȡһȸͷŵĶ
+ * pool - 
+ * ֵָ루δʼڴ治㷵NULL
+ * ˳򣺿 -> ǰslabʣಿ -> һslab -> slab
+ */
+void* record_pool_alloc(RecordPool* pool) {
+    /* һǿʱֱȡͷ */
+    if (pool->free_list != NULL) {
+        void* item = pool->free_list;
+        pool->free_list = *(void**)item;        /* ͷһж */
+        return item;
+    }
+
+    /* ڶǰslabʱתһslabû룩 */
+    if (pool->next_item >= pool->items_per_slab) {
+        if (pool->active_slab + 1 >= pool->slab_count) {
+            if (pool->slab_count == pool->slab_capacity) {   /* slab鱶 */
+                int new_capacity = pool->slab_capacity > 0 ? pool->slab_capacity * 2 : 16;
+                char** grown = (char**)realloc(pool->slabs, (size_t)new_capacity * sizeof(char*));
+                if (grown == NULL) return NULL;
+                pool->slabs = grown;
+                pool->slab_capacity = new_capacity;
+            }
+            char* slab = (char*)malloc(pool->item_size * (size_t)pool->items_per_slab);
+            if (slab == NULL) return NULL;
+            pool->slabs[pool->slab_count++] = slab;
+            pool->active_slab = pool->slab_count - 1;
+        } else {
+            pool->active_slab++;                /* resetslab */
+        }
+        pool->next_item = 0;
+    }
+
+    /* ӵǰslabгһ */
+    return pool->slabs[pool->active_slab] + pool->item_size * (size_t)pool->next_item++;
+}
+
+/*
+ * record_pool_free
+ * ܣ黹أȴ
+ * pool - , item - ɸóطĶ
+ */
+void record_pool_free(RecordPool* pool, void* item) {
+    if (item == NULL) return;
+    *(void**)item = pool->free_list;            /* öͷָ */
+    pool->free_list = item;
+}
+
+/*
+ * record_pool_reset
+ * ܣһԻճȫslabٴз
+ * pool - 
+ * ˵ʱ临ӶO(1)ж޹
+ */
+void record_pool_reset(RecordPool* pool) {
+    pool->free_list = NULL;
+    pool->active_slab = 0;
+    pool->next_item = pool->slab_count > 0 ? 0 : pool->items_per_slab;
+}
+
+/*
+ * record_pool_release
+ * ܣȫ󲢰slab黹ϵͳ
+ * pool - 
+ */
+void record_pool_release(RecordPool* pool) {
+    for (int i = 0; i < pool->slab_count; i++) {
+        free(pool->slabs[i]);
+    }
+    free(pool->slabs);
+    pool->slabs = NULL;
+    pool->slab_count = 0;
+    pool->slab_capacity = 0;
+    pool->active_slab = 0;
+    pool->next_item = pool->items_per_slab;     /* ´ηʱslab */
+    pool->free_list = NULL;
+}
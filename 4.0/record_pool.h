@@ -0,0 +1,63 @@
+#ifndef RECORD_POOL_H
+#define RECORD_POOL_H
+
+#include <stddef.h>
+
+/*
+ * أslab
+ * ϵͳһһ(slab)гɵȳСţ
+ * ͷŵСȸã¼ʱһԻա
+ * ڵÿԱһݵС󣬱ÿԱһmalloc/free
+ */
+
+typedef struct RecordPool {
+    size_t item_size;           /* СѰָС룩 */
+    int items_per_slab;         /* ÿslabзֵĶ */
+    char** slabs;               /* slab */
+    int slab_count;             /* slab */
+    int slab_capacity;          /* slab */
+    int active_slab;            /* зֵslab± */
+    int next_item;              /* ǰslabһδзֶ */
+    void* free_list;            /* ͷŶĿ */
+} RecordPool;
+
+/* ؾ̬ʼ꣺item_typeΪͣper_slabΪÿ */
+#define RECORD_POOL_INIT(item_type, per_slab) \
+    { ((sizeof(item_type) + sizeof(void*) - 1) / sizeof(void*)) * sizeof(void*), \
+      (per_slab), NULL, 0, 0, 0, (per_slab), NULL }
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * record_pool_alloc
+ * ܣӶȡһȸͷŵĶ
+ * pool - 
+ * ֵָ루δʼڴ治㷵NULL
+ */
+void* record_pool_alloc(RecordPool* pool);
+
+/*
+ * record_pool_free
+ * ܣ黹أȴ
+ * pool - , item - ɸóطĶ
+ */
+void record_pool_free(RecordPool* pool, void* item);
+
+/*
+ * record_pool_reset
+ * ܣһԻճȫslabٴз
+ * pool - 
+ */
+void record_pool_reset(RecordPool* pool);
+
+/*
+ * record_pool_release
+ * ܣȫ󲢰slab黹ϵͳ
+ * pool - 
+ */
+void record_pool_release(RecordPool* pool);
+
+#endif /* RECORD_POOL_H */
@@ -1,9 +1,36 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <float.h>
 #include "data_struct.h"
+#include "player_store.h"
+#include "team_pool.h"
+#include "team_index.h"
+#include "player_manager.h"
+#include "parallel.h"
+#include "efficiency_batch.h"
+#include "aggregate_index.h"
+#include "leaderboard.h"
 #include "stats_calculator.h"
 
+#define STATS_BLOCK_RECORDS 1024              /* ͳʱÿתóеļ¼кϼԼ9KBL1 */
+#define PARALLEL_STATS_MIN_RECORDS 262144     /* ÿͳ߳ٷֵļ¼Աʱ߳ͳ */
+
+/*
+ * ͳΣһ̸߳λΧ䲿ֽ
+ */
+typedef struct StatsRange {
+    int first, last;                        /* λΧ[first, last) */
+    int64_t total_height, total_weight;     /* ߡܺ */
+    int max_height, min_height;             /* ߼ֵ */
+    int max_weight, min_weight;             /* ؼֵ */
+    int tallest, shortest;                  /* ֵڲλ-1ʾΪ */
+    int heaviest, lightest;
+    int position_counts[256];               /* λñֱӼǷ± */
+} StatsRange;
+
+static const int position_bonus[POSITION_COUNT] = {5, 6, 7, 8, 9};   /* λüȨPG SG SF PF C */
+
 /*
  * calculate_player_efficiency
  * ܣԱЧֵ򻯰PER㷨
@@ -11,6 +38,7 @@
  * ֵЧֵԽ߱ʾЧԽ
  * 㷨ʽ/10 + (200-)/5 + º/2 + λüȨ
  * ˼·ۺϿλص
+ * ˵㣨efficiency_batch.hЧʷЧֵԱΪ׼ʽĶʱͬ޸
  */
 float calculate_player_efficiency(const Player* player) {
     if (player == NULL) return 0.0f;            /* ָ */
@@ -22,62 +50,357 @@ float calculate_player_efficiency(const Player* player) {
     efficiency += (200.0f - player->weight) / 5.0f;    /* عףӽ׼ص÷ָ */
     efficiency += (float)player->jersey / 2.0f;        /* ºŹףԽ÷Խ */
     
-    /* ڶ֣λüȨ֣ռ40% */
-    if (strcmp(player->position, "PG") == 0) {         /* Ȩ */
-        efficiency += 5.0f;                            /* PGҪ֯ */
-    } else if (strcmp(player->position, "SG") == 0) {  /* ÷ֺȨ */
-        efficiency += 6.0f;                            /* SGҪ÷ */
-    } else if (strcmp(player->position, "SF") == 0) {  /* СǰȨ */
-        efficiency += 7.0f;                            /* SFҪȫ */
-    } else if (strcmp(player->position, "PF") == 0) {  /* ǰȨ */
-        efficiency += 8.0f;                            /* PFҪ */
-    } else if (strcmp(player->position, "C") == 0) {   /* зȨ */
-        efficiency += 9.0f;                            /* CҪ */
+    /* ڶ֣λüȨ֣ռ40%λñȽ */
+    switch (player->position) {
+        case POSITION_PG:                              /* Ȩ */
+            efficiency += 5.0f;                        /* PGҪ֯ */
+            break;
+        case POSITION_SG:                              /* ÷ֺȨ */
+            efficiency += 6.0f;                        /* SGҪ÷ */
+            break;
+        case POSITION_SF:                              /* СǰȨ */
+            efficiency += 7.0f;                        /* SFҪȫ */
+            break;
+        case POSITION_PF:                              /* ǰȨ */
+            efficiency += 8.0f;                        /* PFҪ */
+            break;
+        case POSITION_C:                               /* зȨ */
+            efficiency += 9.0f;                        /* CҪ */
+            break;
+        default:                                       /* Ƿλòӷ */
+            break;
     }
     
     return efficiency;                                 /* Чֵ */
 }
 
+/*
+ * calculate_efficiency_score
+ * ܣԱЧʷ֣Чֵ10
+ * player - Աṹָ
+ * ֵЧʷ
+ * ˼·Чֵ0.110Ǿȷ
+ *           аȽϣܸӰ
+ */
+int64_t calculate_efficiency_score(const Player* player) {
+    int64_t score = (int64_t)player->height + 2 * (200 - (int64_t)player->weight) + 5 * (int64_t)player->jersey;
+    if (player->position < POSITION_COUNT) {
+        score += 10 * position_bonus[player->position];
+    }
+    return score;
+}
+
+/*
+ * first_slot_of
+ * ܣһҳһvalue±꣨valueУ
+ */
+static int first_slot_of(const int* column, int value) {
+    int i = 0;
+    while (column[i] != value) i++;
+    return i;
+}
+
+/*
+ * scan_range
+ * ܣͳһΣparallel_run
+ * arg - StatsRange*
+ * ˼·STATS_BLOCK_RECORDSһ飬Ȱߡءλпջϵ
+ *           Ψһһζȡ¼һֵܺ͡λü
+ *           ֵֵСֱֵλñΪ±꣬ѭûз֧
+ *           ֻбļֵǰʱŻͷڵĲλֵͬǰ
+ */
+static void scan_range(void* arg) {
+    StatsRange* range = (StatsRange*)arg;
+    int height[STATS_BLOCK_RECORDS];        /*  */
+    int weight[STATS_BLOCK_RECORDS];        /*  */
+    uint8_t position[STATS_BLOCK_RECORDS];  /* λ */
+    
+    for (int first = range->first; first < range->last; first += STATS_BLOCK_RECORDS) {
+        int n = range->last - first;
+        if (n > STATS_BLOCK_RECORDS) n = STATS_BLOCK_RECORDS;
+        const Player* records = player_store.records + first;
+        for (int i = 0; i < n; i++) {       /* ת */
+            height[i] = records[i].height;
+            weight[i] = records[i].weight;
+            position[i] = records[i].position;
+        }
+        
+        int64_t sum_height = 0, sum_weight = 0;
+        int max_height = height[0], min_height = height[0];
+        int max_weight = weight[0], min_weight = weight[0];
+        for (int i = 0; i < n; i++) {       /* ںϵһˣֵܺ͡λü */
+            sum_height += height[i];
+            sum_weight += weight[i];
+            max_height = height[i] > max_height ? height[i] : max_height;
+            min_height = height[i] < min_height ? height[i] : min_height;
+            max_weight = weight[i] > max_weight ? weight[i] : max_weight;
+            min_weight = weight[i] < min_weight ? weight[i] : min_weight;
+            range->position_counts[position[i]]++;
+        }
+        range->total_height += sum_height;
+        range->total_weight += sum_weight;
+        
+        /* ˢ˼ֵʱŶλԱȵĿ */
+        if (range->tallest < 0 || max_height > range->max_height) {
+            range->max_height = max_height;
+            range->tallest = first + first_slot_of(height, max_height);
+        }
+        if (range->shortest < 0 || min_height < range->min_height) {
+            range->min_height = min_height;
+            range->shortest = first + first_slot_of(height, min_height);
+        }
+        if (range->heaviest < 0 || max_weight > range->max_weight) {
+            range->max_weight = max_weight;
+            range->heaviest = first + first_slot_of(weight, max_weight);
+        }
+        if (range->lightest < 0 || min_weight < range->min_weight) {
+            range->min_weight = min_weight;
+            range->lightest = first + first_slot_of(weight, min_weight);
+        }
+    }
+}
+
+/*
+ * calculate_league_stats
+ * ܣһɨȫԱͳƱȫ
+ * stats - ͳƽ
+ * 㷨ȫͬһɨеõÿ¼ֻȡһΣʱȡڴ
+ *       Աܶʱλг߳ͬͬʱͳƣٰ˳ϲ
+ *       ֵͬʱǰεԱȣ뵥߳ͬ
+ */
+void calculate_league_stats(LeagueStats* stats) {
+    memset(stats, 0, sizeof(LeagueStats));
+    stats->tallest = stats->shortest = stats->heaviest = stats->lightest = -1;
+    stats->player_count = player_store.count;
+    if (player_store.count == 0) {
+        return;
+    }
+    
+    int workers = parallel_worker_count(player_store.count, PARALLEL_STATS_MIN_RECORDS);
+    StatsRange* ranges = (StatsRange*)calloc((size_t)workers, sizeof(StatsRange));
+    StatsRange single;                          /* ڴ治ʱ߳ͳ */
+    if (ranges == NULL) {
+        memset(&single, 0, sizeof(single));
+        ranges = &single;
+        workers = 1;
+    }
+    for (int w = 0; w < workers; w++) {
+        ranges[w].first = (int)((long long)player_store.count * w / workers);
+        ranges[w].last = (int)((long long)player_store.count * (w + 1) / workers);
+        ranges[w].tallest = ranges[w].shortest = ranges[w].heaviest = ranges[w].lightest = -1;
+    }
+    parallel_run(scan_range, ranges, sizeof(StatsRange), workers);
+    
+    const StatsRange* best_tall = &ranges[0], * best_short = &ranges[0];
+    const StatsRange* best_heavy = &ranges[0], * best_light = &ranges[0];
+    for (int w = 0; w < workers; w++) {         /* ˳ϲ */
+        const StatsRange* range = &ranges[w];
+        stats->total_height += range->total_height;
+        stats->total_weight += range->total_weight;
+        for (int position = 0; position < POSITION_COUNT; position++) {
+            stats->position_counts[position] += range->position_counts[position];
+        }
+        if (range->max_height > best_tall->max_height) best_tall = range;
+        if (range->min_height < best_short->min_height) best_short = range;
+        if (range->max_weight > best_heavy->max_weight) best_heavy = range;
+        if (range->min_weight < best_light->min_weight) best_light = range;
+    }
+    stats->tallest = best_tall->tallest;
+    stats->shortest = best_short->shortest;
+    stats->heaviest = best_heavy->heaviest;
+    stats->lightest = best_light->lightest;
+    if (ranges != &single) {
+        free(ranges);
+    }
+}
+
+/*
+ * current_league_stats
+ * ܣͳƻֱȡͳƽ
+ * stats - ͳƽ
+ * ˵O(1)޹أֵԱֵͬʱΪһ
+ */
+void current_league_stats(LeagueStats* stats) {
+    memset(stats, 0, sizeof(LeagueStats));
+    stats->tallest = stats->shortest = stats->heaviest = stats->lightest = -1;
+    if (!ensure_player_indexes(INDEX_AGGREGATE)) {   /* ֻӳģʽ״ͳʱ */
+        calculate_league_stats(stats);          /* ڴ治ʱ˻ɨ */
+        return;
+    }
+    const Aggregate* league = aggregate_index_league();
+    stats->player_count = league->count;
+    stats->total_height = league->total_height;
+    stats->total_weight = league->total_weight;
+    memcpy(stats->position_counts, league->position_counts, sizeof(stats->position_counts));
+    if (league->count > 0) {                    /* Ϊλ */
+        stats->tallest = (int)(player_store_get(aggregate_index_extreme(AGGREGATE_HEIGHT, 1)) - player_store.records);
+        stats->shortest = (int)(player_store_get(aggregate_index_extreme(AGGREGATE_HEIGHT, 0)) - player_store.records);
+        stats->heaviest = (int)(player_store_get(aggregate_index_extreme(AGGREGATE_WEIGHT, 1)) - player_store.records);
+        stats->lightest = (int)(player_store_get(aggregate_index_extreme(AGGREGATE_WEIGHT, 0)) - player_store.records);
+    }
+}
+
+/*
+ * aggregate_total_efficiency
+ * ܣɻԱЧֵܺ
+ * ˼·ЧֵߡءºŵһʽλüȨֻܺܺλ
+ *           ˫ȼ㣬ûۻ
+ * ˵ʽcalculate_player_efficiencyһ
+ */
+static double aggregate_total_efficiency(const Aggregate* aggregate) {
+    double total = (double)aggregate->total_height / 10.0;
+    total += (200.0 * aggregate->count - (double)aggregate->total_weight) / 5.0;
+    total += (double)aggregate->total_jersey / 2.0;
+    for (int position = 0; position < POSITION_COUNT; position++) {
+        total += (double)position_bonus[position] * aggregate->position_counts[position];
+    }
+    return total;
+}
+
 /*
  * calculate_team_average_stats
  * ܣָӵƽͳ
  * team_name - ƣͳƸöԱ
  * ֵޣֱӴӡͳƽ
  * ͳԱƽߡƽءƽЧֵ
+ * 㷨ֱӶȡͳƻиöӵĻ֣O(1)޹
  */
 void calculate_team_average_stats(const char* team_name) {
-    if (player_list == NULL) {                  /*  */
+    if (player_store.count == 0) {              /* մ洢 */
         printf("Ա\n");               /* ʾû */
         return;                                 /* ǰ */
     }
     
-    Player* current = player_list;              /* ͷڵ㿪ʼ */
-    int player_count = 0;                       /* Ա */
-    int total_height = 0;                       /* ۼ */
-    int total_weight = 0;                       /* ۼ */
-    float total_efficiency = 0.0f;              /* Чֵۼ */
-    
-    while (current != NULL) {                   /*  */
-        if (strcmp(current->team, team_name) == 0) { /* Ƚ */
-            player_count++;                     /* ƥӣ */
-            total_height += current->height;    /* ۼ */
-            total_weight += current->weight;    /* ۼ */
-            total_efficiency += calculate_player_efficiency(current); /* ۼЧֵ */
-        }
-        current = current->next;                /* ƶһڵ */
-    }
+    ensure_player_indexes(INDEX_TEAM | INDEX_AGGREGATE);  /* ֻӳģʽ״ͳʱ */
+    const Aggregate* team = aggregate_index_team(team_pool_find(team_name));
+    int player_count = team->count;             /*  */
     
     if (player_count == 0) {                    /* δҵԱ */
         printf("δҵ %s Ա\n", team_name);
+        display_team_names();                   /* гӹο */
         return;                                 /* ǰ */
     }
     
     /* 㲢ƽֵ */
     printf("\n===  %s ͳƱ ===\n", team_name);
     printf("Ա%d \n", player_count);
-    printf("ƽߣ%.1f cm\n", (float)total_height / player_count);
-    printf("ƽأ%.1f kg\n", (float)total_weight / player_count);
-    printf("ƽЧֵ%.1f \n", total_efficiency / player_count);
+    printf("ƽߣ%.1f cm\n", (double)team->total_height / player_count);
+    printf("ƽأ%.1f kg\n", (double)team->total_weight / player_count);
+    printf("ƽЧֵ%.1f \n", aggregate_total_efficiency(team) / player_count);
+}
+
+/*
+ * recount_team
+ * ܣӻᣬͷöӵĻ
+ */
+static void recount_team(int team_id, Aggregate* aggregate) {
+    const PlayerHandle* roster = NULL;
+    int count = team_index_roster(team_id, &roster);
+    memset(aggregate, 0, sizeof(Aggregate));
+    for (int i = 0; i < count; i++) {
+        const Player* current = player_store_get(roster[i]);
+        aggregate->count++;
+        aggregate->total_height += current->height;
+        aggregate->total_weight += current->weight;
+        aggregate->total_jersey += current->jersey;
+        if (current->position < POSITION_COUNT) {
+            aggregate->position_counts[current->position]++;
+        }
+    }
+}
+
+/*
+ * calculate_indexed_league_stats
+ * ܣɨ裬ֻͳδųӱźϷļ¼ͳƻǼǵķΧͬ
+ * ˵ֻӳģʽм¼𻵻ӱԽδʱ˶ʹ
+ */
+static void calculate_indexed_league_stats(LeagueStats* stats) {
+    memset(stats, 0, sizeof(LeagueStats));
+    stats->tallest = stats->shortest = stats->heaviest = stats->lightest = -1;
+    const Player* records = player_store.records;
+    for (int i = 0; i < player_store.count; i++) {
+        const Player* current = &records[i];
+        if (player_store_excluded(i) || current->team_id >= team_pool_count()) {
+            continue;                           /* δܵļ¼ */
+        }
+        stats->player_count++;
+        stats->total_height += current->height;
+        stats->total_weight += current->weight;
+        if (current->position < POSITION_COUNT) {
+            stats->position_counts[current->position]++;
+        }
+        if (stats->tallest < 0 || current->height > records[stats->tallest].height) stats->tallest = i;
+        if (stats->shortest < 0 || current->height < records[stats->shortest].height) stats->shortest = i;
+        if (stats->heaviest < 0 || current->weight > records[stats->heaviest].weight) stats->heaviest = i;
+        if (stats->lightest < 0 || current->weight < records[stats->lightest].weight) stats->lightest = i;
+    }
+}
+
+/*
+ * check_stats_aggregates
+ * ܣ˶ͳƻ¼ĽǷһ
+ * 
+ * ֵһµ0ʾһ£ÿһ¶ӡ˵
+ * ˵calculate_league_statsɨȽϣֵȽֵֵͬԱԲͬ
+ *       м¼𻵻ӱԽδʱֻɨ¼ĽȽϣ
+ *       ӻĽȽ
+ */
+int check_stats_aggregates(void) {
+    if (!ensure_player_indexes(INDEX_TEAM | INDEX_AGGREGATE)) {
+        printf("ڴ治㣬޷ͳƻ\n");
+        return 1;
+    }
+    int mismatches = 0;
+    LeagueStats expected, actual;
+    if (skipped_player_records() > 0) {
+        calculate_indexed_league_stats(&expected);   /* ļ¼һ */
+    } else {
+        calculate_league_stats(&expected);
+    }
+    current_league_stats(&actual);
+    if (expected.player_count != actual.player_count ||
+        expected.total_height != actual.total_height || expected.total_weight != actual.total_weight ||
+        memcmp(expected.position_counts, actual.position_counts, sizeof(expected.position_counts)) != 0) {
+        printf("ܲһ£ %d/%d\n", actual.player_count, expected.player_count);
+        mismatches++;
+    }
+    if (expected.player_count > 0 && actual.player_count > 0) {
+        const Player* records = player_store.records;
+        if (records[expected.tallest].height != records[actual.tallest].height ||
+            records[expected.shortest].height != records[actual.shortest].height ||
+            records[expected.heaviest].weight != records[actual.heaviest].weight ||
+            records[expected.lightest].weight != records[actual.lightest].weight) {
+            printf("߻ؼֵһ\n");
+            mismatches++;
+        }
+    }
+    for (int team_id = 0; team_id < team_pool_count(); team_id++) {
+        Aggregate recount;
+        recount_team(team_id, &recount);
+        if (memcmp(&recount, aggregate_index_team(team_id), sizeof(Aggregate)) != 0) {
+            printf(" %s ܲһ\n", team_pool_name(team_id));
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+/*
+ * display_team_names
+ * ܣгǰԱȫӼ
+ * 
+ * ֵޣֱӴӡ
+ */
+void display_team_names() {
+    const PlayerHandle* roster = NULL;          /* ᣨ˴ֻ */
+    ensure_player_indexes(INDEX_TEAM);
+    printf("ӣ\n");
+    for (int team_id = 0; team_id < team_pool_count(); team_id++) {
+        int size = team_index_roster(team_id, &roster);
+        if (size > 0) {                         /* Ա */
+            printf("  %s%d ˣ\n", team_pool_name(team_id), size);
+        }
+    }
 }
 
 /*
@@ -85,23 +408,34 @@ void calculate_team_average_stats(const char* team_name) {
  * ܣвЧֵߵԱ
  * 
  * ֵЧߵԱָ룬ûԱNULL
- * 㷨¼ֵʱ临ӶO(n)
+ * 㷨ֱȡЧаڵ1λԱͬʱѧСߣ޹أ
+ *       ڴ治޷аʱ˻˳ɨ裬Чֵ¼ֵ
  */
 Player* find_most_efficient_player() {
-    if (player_list == NULL) return NULL;       /*  */
+    if (player_store.count == 0) return NULL;   /* մ洢 */
+    
+    PlayerHandle top;
+    if (ensure_player_indexes(INDEX_LEADERBOARD) &&   /* ֻӳģʽ״βѯʱ */
+        leaderboard_page(LEADERBOARD_LEAGUE, 0, 1, 1, &top) == 1) {
+        return player_store_get(top);
+    }
     
-    Player* current = player_list;              /* ǰڵ */
-    Player* best_player = player_list;          /* ǰԱָ */
-    float max_efficiency = 0.0f;                /* ǰЧֵ */
+    Player* best_player = NULL;                 /* ǰԱָ */
+    float max_efficiency = -FLT_MAX;            /* ǰЧֵЧֵΪ */
+    float efficiency[EFFICIENCY_BATCH_BLOCK];   /* һԱЧֵ */
     
-    while (current != NULL) {                   /*  */
-        float efficiency = calculate_player_efficiency(current);
-        if (efficiency > max_efficiency) {      /* ָЧֵ */
-            max_efficiency = efficiency;        /* Чֵ */
-            best_player = current;              /* Աָ */
+    for (int first = 0; first < player_store.count; first += EFFICIENCY_BATCH_BLOCK) {   /* ˳ɨ */
+        int n = player_store.count - first;
+        if (n > EFFICIENCY_BATCH_BLOCK) n = EFFICIENCY_BATCH_BLOCK;
+        efficiency_batch_records(player_store.records + first, n, efficiency);
+        for (int i = 0; i < n; i++) {
+            if ((best_player == NULL || efficiency[i] > max_efficiency) &&
+                !player_store_excluded(first + i)) {   /* ָЧֵ𻵵ļ¼ */
+                max_efficiency = efficiency[i];     /* Чֵ */
+                best_player = &player_store.records[first + i];   /* Աָ */
+            }
         }
-        current = current->next;                /* ƶһڵ */
     }
     
-    return best_player;                         /* ЧߵԱ */
+    return best_player;                         /* ЧߵԱȫųʱΪNULL */
 }
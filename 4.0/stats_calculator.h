@@ -1,8 +1,22 @@
 #ifndef STATS_CALCULATOR_H
 #define STATS_CALCULATOR_H
 
+#include <stdint.h>
 #include "data_struct.h"
 
+/*
+ * ͳƽͳƱеȫ֣calculate_league_statsһɨõ
+ * ֵԱԴ洢λʾplayer_store.records[λ]ֵͬʱȡǰһ
+ */
+typedef struct LeagueStats {
+    int player_count;                       /* Ա */
+    int64_t total_height;                   /* ܺ */
+    int64_t total_weight;                   /* ܺ */
+    int tallest, shortest;                  /* ߡԱĲλûԱʱΪ-1 */
+    int heaviest, lightest;                 /* ءԱĲλûԱʱΪ-1 */
+    int position_counts[POSITION_COUNT];    /* λǷλò */
+} LeagueStats;
+
 /*
  * 
  * кϸĲ˵͹
@@ -16,6 +30,38 @@
  */
 float calculate_player_efficiency(const Player* player);
 
+/*
+ * calculate_efficiency_score
+ * ܣԱЧʷ֣Чֵ10ΪȷаԴ˱Ƚ
+ * player - Աṹָ
+ * ֵЧʷ
+ */
+int64_t calculate_efficiency_score(const Player* player);
+
+/*
+ * calculate_league_stats
+ * ܣһɨȫԱͳƱȫ
+ * stats - ͳƽ
+ * ˵ֻ㲻ӡʽdisplay_statistics_report
+ */
+void calculate_league_stats(LeagueStats* stats);
+
+/*
+ * current_league_stats
+ * ܣͳƻֱȡͳƽO(1)aggregate_index.h
+ * stats - ͳƽ
+ * ˵calculate_league_statsֵͬԱֵͬʱһ
+ */
+void current_league_stats(LeagueStats* stats);
+
+/*
+ * check_stats_aggregates
+ * ܣ˶ͳƻ¼ĽǷһ
+ * 
+ * ֵһµ0ʾһ£ÿһ¶ӡ˵
+ */
+int check_stats_aggregates(void);
+
 /*
  * calculate_team_average_stats
  * ܣָӵƽͳ
@@ -24,11 +70,19 @@ float calculate_player_efficiency(const Player* player);
  */
 void calculate_team_average_stats(const char* team_name);
 
+/*
+ * display_team_names
+ * ܣгǰԱȫӼ
+ * 
+ * ֵޣֱӴӡ
+ */
+void display_team_names();
+
 /*
  * find_most_efficient_player
  * ܣвЧֵߵԱ
  * 
- * ֵЧߵԱָ룬ûԱNULL
+ * ֵЧߵԱָ루ͬʱѧСߣûԱNULL
  */
 Player* find_most_efficient_player();
 
@@ -0,0 +1,165 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "data_struct.h"
+#include "player_store.h"
+#include "team_pool.h"
+#include "team_index.h"
+
+/*
+ * ӻ᣺Ա
+ */
+typedef struct TeamRoster {
+    PlayerHandle* handles;      /*  */
+    int count;                  /*  */
+    int capacity;               /*  */
+} TeamRoster;
+
+static TeamRoster* rosters = NULL;       /* 飬±꼴ӱ */
+static int roster_count = 0;             /* ѷĻ */
+
+static int* handle_team = NULL;          /*  -> ӱţ-1ʾδǼ */
+static int* handle_position = NULL;      /*  -> ڻе± */
+static int handle_capacity = 0;          /*  */
+
+/*
+ * reserve_rosters
+ * ܣ֤±team_id»Ϊ
+ */
+static int reserve_rosters(int team_id) {
+    if (team_id < roster_count) return 1;
+    int new_count = roster_count > 0 ? roster_count : 16;
+    while (new_count <= team_id) {
+        new_count *= 2;
+    }
+    TeamRoster* grown = (TeamRoster*)realloc(rosters, (size_t)new_count * sizeof(TeamRoster));
+    if (grown == NULL) return 0;
+    memset(&grown[roster_count], 0, (size_t)(new_count - roster_count) * sizeof(TeamRoster));
+    rosters = grown;
+    roster_count = new_count;
+    return 1;
+}
+
+/*
+ * reserve_handles
+ * ܣ֤ӳ±handle
+ */
+static int reserve_handles(PlayerHandle handle) {
+    if (handle < handle_capacity) return 1;
+    int new_capacity = handle_capacity > 0 ? handle_capacity : 64;
+    while (new_capacity <= handle) {
+        new_capacity *= 2;
+    }
+    int* grown_team = (int*)realloc(handle_team, (size_t)new_capacity * sizeof(int));
+    if (grown_team == NULL) return 0;
+    handle_team = grown_team;
+    int* grown_position = (int*)realloc(handle_position, (size_t)new_capacity * sizeof(int));
+    if (grown_position == NULL) return 0;
+    handle_position = grown_position;
+    for (int i = handle_capacity; i < new_capacity; i++) {
+        handle_team[i] = -1;                    /* ¾δǼ */
+    }
+    handle_capacity = new_capacity;
+    return 1;
+}
+
+/*
+ * team_index_insert
+ * ܣԱӵĻ
+ * team_id - ӱ, handle - Ա
+ * ֵ1ʾɹ0ʾڴ治ŷǷ
+ */
+int team_index_insert(int team_id, PlayerHandle handle) {
+    if (team_id < 0 || team_id >= team_pool_count()) return 0;   /* ŷǷ */
+    if (!reserve_handles(handle)) return 0;
+    if (!reserve_rosters(team_id)) return 0;
+
+    TeamRoster* roster = &rosters[team_id];
+    if (roster->count == roster->capacity) {    /* ᱶ */
+        int new_capacity = roster->capacity > 0 ? roster->capacity * 2 : 8;
+        PlayerHandle* grown = (PlayerHandle*)realloc(roster->handles,
+                                                     (size_t)new_capacity * sizeof(PlayerHandle));
+        if (grown == NULL) return 0;
+        roster->handles = grown;
+        roster->capacity = new_capacity;
+    }
+    handle_team[handle] = team_id;              /* ¼λ */
+    handle_position[handle] = roster->count;
+    roster->handles[roster->count++] = handle;
+    return 1;
+}
+
+/*
+ * team_index_remove
+ * ܣԱӵĻƳ
+ * handle - Ա
+ * ֵ1ʾƳɹ0ʾδǼ
+ * 㷨ĩβλO(1)
+ */
+int team_index_remove(PlayerHandle handle) {
+    if (handle < 0 || handle >= handle_capacity || handle_team[handle] < 0) {
+        return 0;                               /* δǼ */
+    }
+    TeamRoster* roster = &rosters[handle_team[handle]];
+    int position = handle_position[handle];
+    PlayerHandle moved = roster->handles[--roster->count];
+    roster->handles[position] = moved;          /* ĩβλ */
+    handle_position[moved] = position;
+    handle_team[handle] = -1;
+    return 1;
+}
+
+/*
+ * team_index_roster
+ * ܣȡӻ
+ * team_id - ӱ, roster - ׵ַһɾǰЧ
+ * ֵöԱŷǷ0
+ */
+int team_index_roster(int team_id, const PlayerHandle** roster) {
+    if (team_id < 0 || team_id >= roster_count) {
+        *roster = NULL;                         /* ŷǷöӴδԱ */
+        return 0;
+    }
+    *roster = rosters[team_id].handles;
+    return rosters[team_id].count;
+}
+
+/*
+ * team_index_rebuild
+ * ܣǰ洢ؽ
+ * 
+ * ֵӱԽųplayer_store_excludedļ¼ڴ治㷵-1
+ */
+int team_index_rebuild(void) {
+    team_index_release();
+    int skipped = 0;                            /* ļ¼ */
+    for (int i = 0; i < player_store.count; i++) {
+        if (player_store_excluded(i) || player_store.records[i].team_id >= team_pool_count()) {
+            skipped++;                          /* ֻӳļǼ */
+            continue;
+        }
+        if (!team_index_insert(player_store.records[i].team_id, player_store_handle_at(i))) {
+            return -1;
+        }
+    }
+    return skipped;
+}
+
+/*
+ * team_index_release
+ * ܣͷռõȫڴ
+ * 
+ */
+void team_index_release(void) {
+    for (int t = 0; t < roster_count; t++) {
+        free(rosters[t].handles);
+    }
+    free(rosters);
+    free(handle_team);
+    free(handle_position);
+    rosters = NULL;
+    roster_count = 0;
+    handle_team = NULL;
+    handle_position = NULL;
+    handle_capacity = 0;
+}
@@ -0,0 +1,57 @@
+#ifndef TEAM_INDEX_H
+#define TEAM_INDEX_H
+
+#include "player_store.h"
+
+/*
+ * ģ
+ * ӱţteam_pool.h -> öԱ飨ᣩ
+ * ÿ¼ԼڻеλãɾΪO(1)
+ * ͳֻöӻᣬʱȣ޹
+ */
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * team_index_insert
+ * ܣԱӵĻ
+ * team_id - ӱ, handle - Ա
+ * ֵ1ʾɹ0ʾڴ治ŷǷ
+ */
+int team_index_insert(int team_id, PlayerHandle handle);
+
+/*
+ * team_index_remove
+ * ܣԱӵĻƳ
+ * handle - Ա
+ * ֵ1ʾƳɹ0ʾδǼ
+ */
+int team_index_remove(PlayerHandle handle);
+
+/*
+ * team_index_roster
+ * ܣȡӻ
+ * team_id - ӱ, roster - ׵ַһɾǰЧ
+ * ֵöԱŷǷ0
+ */
+int team_index_roster(int team_id, const PlayerHandle** roster);
+
+/*
+ * team_index_rebuild
+ * ܣǰ洢ؽ
+ * 
+ * ֵӱԽųplayer_store_excludedļ¼ڴ治㷵-1
+ */
+int team_index_rebuild(void);
+
+/*
+ * team_index_release
+ * ܣͷռõȫڴ
+ * 
+ */
+void team_index_release(void);
+
+#endif /* TEAM_INDEX_H */
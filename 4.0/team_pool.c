@@ -0,0 +1,146 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "team_pool.h"
+
+/*
+ * פĿ뻺Ĺϣֵ
+ */
+typedef struct TeamName {
+    char name[TEAM_NAME_SIZE];  /*  */
+    unsigned int hash;          /* ƹϣֵ */
+} TeamName;
+
+static TeamName* names = NULL;           /* 飬±꼴ӱ */
+static int name_count = 0;               /* ѷ */
+static int name_capacity = 0;            /*  */
+
+static int* buckets = NULL;              /* ŶַϣͰڴűţ-1Ϊ */
+static int bucket_count = 0;             /* Ͱ2 */
+
+/*
+ * hash_name
+ * ܣƵFNV-1aϣֵ
+ */
+static unsigned int hash_name(const char* name) {
+    unsigned int hash = 2166136261u;            /* FNVƫƻ */
+    while (*name != '\0') {
+        hash ^= (unsigned char)*name++;
+        hash *= 16777619u;                      /* FNV */
+    }
+    return hash;
+}
+
+/*
+ * rehash
+ * ܣͰؽϣ
+ */
+static int rehash(int new_bucket_count) {
+    int* table = (int*)malloc((size_t)new_bucket_count * sizeof(int));
+    if (table == NULL) return 0;
+    for (int i = 0; i < new_bucket_count; i++) {
+        table[i] = -1;
+    }
+    for (int id = 0; id < name_count; id++) {   /* ·ȫ */
+        int pos = (int)(names[id].hash & (unsigned int)(new_bucket_count - 1));
+        while (table[pos] >= 0) {
+            pos = (pos + 1) & (new_bucket_count - 1);
+        }
+        table[pos] = id;
+    }
+    free(buckets);
+    buckets = table;
+    bucket_count = new_bucket_count;
+    return 1;
+}
+
+/*
+ * team_pool_find
+ * ܣƶӦıţ±
+ * name - 
+ * ֵӱţδǼǷ-1
+ */
+int team_pool_find(const char* name) {
+    if (bucket_count == 0) return -1;           /* ձ */
+    char key[TEAM_NAME_SIZE];                   /* ǼʱͬĽضϹ */
+    memset(key, 0, sizeof(key));
+    strncpy(key, name, sizeof(key) - 1);
+    unsigned int hash = hash_name(key);
+    int pos = (int)(hash & (unsigned int)(bucket_count - 1));
+    while (buckets[pos] >= 0) {
+        const TeamName* entry = &names[buckets[pos]];
+        if (entry->hash == hash && strcmp(entry->name, key) == 0) {
+            return buckets[pos];
+        }
+        pos = (pos + 1) & (bucket_count - 1);
+    }
+    return -1;
+}
+
+/*
+ * team_pool_intern
+ * ܣȡƶӦıţ״γʱ±
+ * name - ƣ30ֽڵĲֱضϣ
+ * ֵӱţڴ治þ-1
+ */
+int team_pool_intern(const char* name) {
+    int team_id = team_pool_find(name);
+    if (team_id >= 0) return team_id;           /* ѵǼ */
+    if (name_count >= TEAM_POOL_MAX_TEAMS) return -1;   /* þ */
+
+    if ((name_count + 1) * 2 > bucket_count) {  /* ӱ50% */
+        if (!rehash(bucket_count > 0 ? bucket_count * 2 : 64)) return -1;
+    }
+    if (name_count == name_capacity) {          /* 鱶 */
+        int new_capacity = name_capacity > 0 ? name_capacity * 2 : 16;
+        TeamName* grown = (TeamName*)realloc(names, (size_t)new_capacity * sizeof(TeamName));
+        if (grown == NULL) return -1;
+        names = grown;
+        name_capacity = new_capacity;
+    }
+
+    team_id = name_count++;
+    TeamName* entry = &names[team_id];
+    memset(entry->name, 0, sizeof(entry->name));
+    strncpy(entry->name, name, sizeof(entry->name) - 1);
+    entry->hash = hash_name(entry->name);
+    int pos = (int)(entry->hash & (unsigned int)(bucket_count - 1));
+    while (buckets[pos] >= 0) {
+        pos = (pos + 1) & (bucket_count - 1);
+    }
+    buckets[pos] = team_id;
+    return team_id;
+}
+
+/*
+ * team_pool_name
+ * ܣȡñŶӦ
+ * team_id - ӱ
+ * ֵƣŷǷʱؿַ
+ */
+const char* team_pool_name(int team_id) {
+    if (team_id < 0 || team_id >= name_count) return "";
+    return names[team_id].name;
+}
+
+/*
+ * team_pool_count
+ * ܣȡѷӱϷΪ0ֵ-1
+ * 
+ * ֵӱ
+ */
+int team_pool_count(void) {
+    return name_count;
+}
+
+/*
+ * team_pool_reset
+ * ܣȫƣ´0䣨¼ǰã
+ * 
+ */
+void team_pool_reset(void) {
+    name_count = 0;
+    for (int i = 0; i < bucket_count; i++) {
+        buckets[i] = -1;                        /* Ͱ飬ֻ */
+    }
+}
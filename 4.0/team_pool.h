@@ -0,0 +1,57 @@
+#ifndef TEAM_POOL_H
+#define TEAM_POOL_H
+
+/*
+ * פַפ
+ * ÿֻͬһݣԱ¼н2ֽڵӱ
+ * ȽԱǷֻͬȽϱţֻʾʱת
+ */
+
+#define TEAM_POOL_MAX_TEAMS 65535        /* ӱޣuint16_t */
+#define TEAM_NAME_SIZE 31                /* ƻС */
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * team_pool_intern
+ * ܣȡƶӦıţ״γʱ±
+ * name - ƣ30ֽڵĲֱضϣ
+ * ֵӱţڴ治þ-1
+ */
+int team_pool_intern(const char* name);
+
+/*
+ * team_pool_find
+ * ܣƶӦıţ±
+ * name - 
+ * ֵӱţδǼǷ-1
+ */
+int team_pool_find(const char* name);
+
+/*
+ * team_pool_name
+ * ܣȡñŶӦ
+ * team_id - ӱ
+ * ֵƣŷǷʱؿַ
+ */
+const char* team_pool_name(int team_id);
+
+/*
+ * team_pool_count
+ * ܣȡѷӱϷΪ0ֵ-1
+ * 
+ * ֵӱ
+ */
+int team_pool_count(void);
+
+/*
+ * team_pool_reset
+ * ܣȫƣ´0䣨¼ǰã
+ * 
+ */
+void team_pool_reset(void);
+
+#endif /* TEAM_POOL_H */
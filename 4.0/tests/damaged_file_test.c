@@ -0,0 +1,240 @@
+/*
+ * ============================================================================
+ * ԣ𻵵ļᱻԶ
+ * ʱĿ¼з𻵵players.datħͷļͷ޷ʶ𣩣ͬĲ˵
+ *   1. ֱ˳2. ѡ񱣴沢ܾȷϺ˳  ļһֽڲ䣬Ҳ½־
+ *   3. һԱ˳ȷϸ  ԭļΪplayers.dat.corruptݲ
+ *   4. ԱļиĶһ¼һֽڣֱ˳ 
+ *      ¼ճأļͬһֽڲ
+ *   5. ͬһļһԱĶֻ־УٸĶͬһֽںֱ˳ 
+ *      ־еĸĶճطţ־ļ
+ *   6. ħͷļͷļֱ˳  ͬΪ𻵣һֽڲ
+ * У4.0Ŀ¼£ȱ4.0.exe
+ *   gcc -std=c99 -o tests/damaged_file_test.exe tests/damaged_file_test.c file_format.c crc32c.c
+ *   tests\damaged_file_test.exe
+ * ȫͨʱ˳Ϊ0
+ * ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../file_format.h"
+
+#ifdef _WIN32
+#define RUN_DIR "tests\\damaged_run"
+#define RUN_PROGRAM "cd " RUN_DIR " && ..\\..\\4.0.exe < input.txt > output.txt"
+#define MAKE_RUN_DIR "mkdir " RUN_DIR " 2> nul"
+#else
+#define RUN_DIR "tests/damaged_run"
+#define RUN_PROGRAM "cd " RUN_DIR " && ../../4.0 < input.txt > output.txt"
+#define MAKE_RUN_DIR "mkdir -p " RUN_DIR
+#endif
+
+#define DAMAGED_SIZE 256                         /* ļֽ */
+#define MAX_FILE_SIZE 4096                       /* ļֽ */
+
+static unsigned char damaged[DAMAGED_SIZE];      /* ļԭʼ */
+static int failures = 0;                         /* ʧܵļ */
+
+/*
+ * write_file
+ * ܣһдʱĿ¼еļ
+ */
+static void write_file(const char* name, const void* data, size_t size) {
+    char path[260];
+    snprintf(path, sizeof(path), "%s/%s", RUN_DIR, name);
+    FILE* file_ptr = fopen(path, "wb");
+    if (file_ptr != NULL) {
+        fwrite(data, 1, size, file_ptr);
+        fclose(file_ptr);
+    }
+}
+
+/*
+ * read_file
+ * ܣȡʱĿ¼еļ
+ * ֵֽļڷ0
+ */
+static size_t read_file(const char* name, unsigned char* buffer, size_t capacity) {
+    char path[260];
+    snprintf(path, sizeof(path), "%s/%s", RUN_DIR, name);
+    FILE* file_ptr = fopen(path, "rb");
+    if (file_ptr == NULL) {
+        return 0;
+    }
+    size_t got = fread(buffer, 1, capacity, file_ptr);
+    fclose(file_ptr);
+    return got;
+}
+
+/*
+ * file_matches
+ * ܣжʱĿ¼еļǷֽͬ
+ * ֵ1ʾͬ0ʾڻͬ
+ */
+static int file_matches(const char* name, const unsigned char* data, size_t size) {
+    unsigned char buffer[MAX_FILE_SIZE + 1];
+    size_t got = read_file(name, buffer, sizeof(buffer));
+    return got == size && memcmp(buffer, data, size) == 0;
+}
+
+/*
+ * file_exists
+ * ܣжʱĿ¼еļǷ
+ */
+static int file_exists(const char* name) {
+    char path[260];
+    snprintf(path, sizeof(path), "%s/%s", RUN_DIR, name);
+    FILE* file_ptr = fopen(path, "rb");
+    if (file_ptr == NULL) {
+        return 0;
+    }
+    fclose(file_ptr);
+    return 1;
+}
+
+/*
+ * check
+ * ܣ¼һĽ
+ */
+static void check(int passed, const char* scenario, const char* what) {
+    printf("%s %s%s\n", passed ? "ͨ" : "ʧ", scenario, what);
+    failures += !passed;
+}
+
+/*
+ * build_valid_file
+ * ܣǰʽһһ֧ӡԱļͬwrite_player_snapshot
+ * bytes - MAX_FILE_SIZEֽ
+ * ֵļֽ
+ */
+static size_t build_valid_file(unsigned char* bytes) {
+    Player players[2];
+    memset(players, 0, sizeof(players));
+    strcpy(players[0].id, "202400000001");
+    strcpy(players[0].name, "Zhang San");
+    players[0].id_key = 202400000001ULL;
+    players[0].position = POSITION_PG;
+    players[0].height = 180;
+    players[0].weight = 75;
+    players[0].jersey = 10;
+    strcpy(players[1].id, "202400000002");
+    strcpy(players[1].name, "Li Si");
+    players[1].id_key = 202400000002ULL;
+    players[1].position = POSITION_C;
+    players[1].height = 200;
+    players[1].weight = 95;
+    players[1].jersey = 11;
+    
+    PlayerFileHeader header;
+    PlayerFileFooter footer;
+    file_format_init_header(&header, 2, 1);
+    memset(bytes, 0, (size_t)file_format_file_size(&header));
+    file_format_encode_header(&header, bytes);
+    unsigned char* team = bytes + header.team_table_offset;
+    strcpy((char*)team, "Test");
+    footer.record_count = 2;
+    footer.checksum = file_format_team_checksum(&header, team);
+    for (int i = 0; i < 2; i++) {
+        unsigned char* record = bytes + file_format_record_offset(&header, i);
+        file_format_encode_record(&players[i], record);
+        footer.checksum += file_format_record_checksum(&header, record);
+    }
+    file_format_encode_footer(&footer, bytes + file_format_record_offset(&header, 2));
+    return (size_t)file_format_file_size(&header);
+}
+
+/*
+ * run_program
+ * ܣԸ
+ */
+static void run_program(const char* input) {
+    write_file("input.txt", input, strlen(input));
+    system(RUN_PROGRAM);
+}
+
+/*
+ * clean_run_dir
+ * ܣһµļ־
+ */
+static void clean_run_dir(void) {
+    static const char* leftovers[] = {
+        "players.dat", "players.dat.wal", "players.dat.wal.1", "players.dat.idx",
+        "players.dat.corrupt", "players.dat.wal.corrupt", "players.dat.wal.1.corrupt"
+    };
+    char path[260];
+    for (size_t i = 0; i < sizeof(leftovers) / sizeof(leftovers[0]); i++) {
+        snprintf(path, sizeof(path), "%s/%s", RUN_DIR, leftovers[i]);
+        remove(path);
+    }
+}
+
+/*
+ * run_scenario
+ * ܣ޷ʶļԸ
+ */
+static void run_scenario(const char* input) {
+    clean_run_dir();
+    write_file("players.dat", damaged, sizeof(damaged));
+    run_program(input);
+}
+
+int main(void) {
+    memset(damaged, 0xA5, sizeof(damaged));      /* ļͷ汾ֶξϷ */
+    memcpy(damaged, PLAYER_FILE_MAGIC, PLAYER_FILE_MAGIC_SIZE);
+    system(MAKE_RUN_DIR);
+    
+    run_scenario("0\n");
+    check(file_matches("players.dat", damaged, sizeof(damaged)), "ֱ˳", "ļ");
+    check(!file_exists("players.dat.wal"), "ֱ˳", "δ½־");
+    
+    run_scenario("10\nn\n\n0\nn\n");
+    check(file_matches("players.dat", damaged, sizeof(damaged)), "ܾ˳", "ļ");
+    check(!file_exists("players.dat.wal"), "ܾ˳", "δ½־");
+    
+    run_scenario("1\n202400000001\n\nԶ\nPG\n180\n75\n10\n\n0\ny\n");
+    check(file_matches("players.dat.corrupt", damaged, sizeof(damaged)), "ȷϸ", "ԭļ");
+    check(file_exists("players.dat") && !file_matches("players.dat", damaged, sizeof(damaged)),
+          "ȷϸ", "дµļ");
+    
+    clean_run_dir();
+    unsigned char valid[MAX_FILE_SIZE];
+    size_t size = build_valid_file(valid);
+    valid[size - PLAYER_FILE_FOOTER_SIZE - PLAYER_FILE_RECORD_SIZE + 25] ^= 0x04;   /* һ¼ */
+    write_file("players.dat", valid, size);
+    run_program("0\n");
+    check(file_matches("players.dat", valid, size), "", "ļ");
+    check(!file_exists("players.dat.wal"), "", "δ½־");
+    unsigned char output[16384];
+    size_t length = read_file("output.txt", output, sizeof(output) - 1);
+    output[length] = '\0';
+    check(strstr((char*)output, " 1 ԱѼ") != NULL, "", "¼ճ");
+    
+    clean_run_dir();
+    size = build_valid_file(valid);
+    write_file("players.dat", valid, size);
+    run_program("1\n202400000003\nWang Wu\nTest\nSF\n190\n85\n12\n\n0\n");
+    unsigned char journal[MAX_FILE_SIZE + 1];
+    size_t journal_size = read_file("players.dat.wal", journal, sizeof(journal));
+    valid[size - PLAYER_FILE_FOOTER_SIZE - PLAYER_FILE_RECORD_SIZE + 25] ^= 0x04;
+    write_file("players.dat", valid, size);
+    run_program("0\n");
+    check(file_matches("players.dat", valid, size), "־", "ļ");
+    check(journal_size > 0 && file_matches("players.dat.wal", journal, journal_size),
+          "־", "־");
+    length = read_file("output.txt", output, sizeof(output) - 1);
+    output[length] = '\0';
+    check(strstr((char*)output, " 2 ԱѼ") != NULL, "־", "־еĸĶճط");
+    
+    clean_run_dir();
+    write_file("players.dat", damaged, PLAYER_FILE_HEADER_SIZE / 2);   /* ضļͷ */
+    run_program("0\n");
+    check(file_matches("players.dat", damaged, PLAYER_FILE_HEADER_SIZE / 2), "ضϵļͷ", "ļ");
+    length = read_file("output.txt", output, sizeof(output) - 1);
+    output[length] = '\0';
+    check(strstr((char*)output, "δκ") != NULL, "ضϵļͷ", "Ϊ");
+    
+    printf("%d ʧ\n", failures);
+    return failures == 0 ? 0 : 1;
+}
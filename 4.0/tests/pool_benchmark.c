@@ -0,0 +1,215 @@
+/*
+ * ============================================================================
+ * ׼ԣڴʱmallocԱ
+ * 洢װԱβ
+ *   1. ״νļʱname_index_rebuild
+ *   2. ٴν¼أرslabʱ룩
+ *   3. һԱעٵǼɾӣ
+ * öһ飬ٸΪÿڵһmalloc/freeʹö֮ǰһ飬
+ * еͬһname_index.cֻнڵķ䷽ʽͬ
+ * ÿͳmalloc/calloc/reallocfreeĵôʱ-D⼸Ϊļе
+ * 汾ֻڱαԴļҪκⲿߣ
+ * صĸͬΪļпл䷽ʽİ汾record_pool.cɱļֱӰ
+ * У4.0Ŀ¼£
+ *   gcc -std=c99 -O2 -Dmalloc=bench_malloc -Dcalloc=bench_calloc -Drealloc=bench_realloc -Dfree=bench_free
+ *       -Drecord_pool_alloc=bench_pool_alloc -Drecord_pool_free=bench_pool_free
+ *       -Drecord_pool_reset=bench_pool_reset -Drecord_pool_release=bench_pool_release
+ *       -o tests/pool_benchmark.exe tests/pool_benchmark.c name_index.c player_store.c parallel.c
+ *   tests\pool_benchmark.exe [Ա]      Ĭ200000
+ * ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../data_struct.h"
+#include "../player_store.h"
+#include "../name_index.h"
+
+#define DEFAULT_PLAYERS 200000                   /* ĬԱ */
+
+/* ճ루еmalloc/freeԼbench_pool_*䷽ʽת */
+#undef record_pool_alloc
+#undef record_pool_free
+#undef record_pool_reset
+#undef record_pool_release
+#include "../record_pool.c"
+
+/*
+ * mallocʱÿڵǰָ룺ػʱfree
+ * ڵԳصfree_listֶΣʱʹãΪͷ˫
+ */
+typedef struct NodeLink {
+    struct NodeLink* prev;
+    struct NodeLink* next;
+} NodeLink;
+
+static int use_pool = 1;                         /* 1ʾأ0ʾmalloc */
+
+void* bench_pool_alloc(RecordPool* pool) {
+    if (use_pool) {
+        return record_pool_alloc(pool);
+    }
+    NodeLink* link = (NodeLink*)malloc(sizeof(NodeLink) + pool->item_size);
+    if (link == NULL) {
+        return NULL;
+    }
+    link->prev = NULL;
+    link->next = (NodeLink*)pool->free_list;
+    if (link->next != NULL) {
+        link->next->prev = link;
+    }
+    pool->free_list = link;
+    return link + 1;
+}
+
+void bench_pool_free(RecordPool* pool, void* item) {
+    if (use_pool) {
+        record_pool_free(pool, item);
+        return;
+    }
+    NodeLink* link = (NodeLink*)item - 1;
+    if (link->prev != NULL) {
+        link->prev->next = link->next;
+    } else {
+        pool->free_list = link->next;
+    }
+    if (link->next != NULL) {
+        link->next->prev = link->prev;
+    }
+    free(link);
+}
+
+void bench_pool_reset(RecordPool* pool) {
+    if (use_pool) {
+        record_pool_reset(pool);
+        return;
+    }
+    NodeLink* link = (NodeLink*)pool->free_list;
+    while (link != NULL) {                       /* ʹö֮ǰͷȫڵ */
+        NodeLink* next = link->next;
+        free(link);
+        link = next;
+    }
+    pool->free_list = NULL;
+}
+
+void bench_pool_release(RecordPool* pool) {
+    if (use_pool) {
+        record_pool_release(pool);
+    } else {
+        bench_pool_reset(pool);
+    }
+}
+
+/* ȡķ亯 */
+#undef malloc
+#undef calloc
+#undef realloc
+#undef free
+void* malloc(size_t size);
+void* calloc(size_t count, size_t size);
+void* realloc(void* block, size_t size);
+void free(void* block);
+
+static long alloc_calls = 0;                     /* malloc/calloc/reallocô */
+static long free_calls = 0;                      /* freeôfree(NULL) */
+
+void* bench_malloc(size_t size) {
+    alloc_calls++;
+    return malloc(size);
+}
+
+void* bench_calloc(size_t count, size_t size) {
+    alloc_calls++;
+    return calloc(count, size);
+}
+
+void* bench_realloc(void* block, size_t size) {
+    alloc_calls++;
+    return realloc(block, size);
+}
+
+void bench_free(void* block) {
+    if (block != NULL) {
+        free_calls++;
+    }
+    free(block);
+}
+
+/*
+ * report
+ * ܣӡһ롢ͷŴʱ
+ */
+static void report(const char* step, clock_t start) {
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("%-28s %-12s %10ld %10ld %10.3f\n", step, use_pool ? "" : "malloc",
+           alloc_calls, free_calls, seconds);
+    alloc_calls = 0;
+    free_calls = 0;
+}
+
+/*
+ * run_steps
+ * ܣǰ䷽ʽβͷ
+ * count - Ա
+ * ֵ1ʾɹ0ʾڴ治
+ */
+static int run_steps(int count) {
+    alloc_calls = 0;
+    free_calls = 0;
+    clock_t start = clock();
+    if (!name_index_rebuild()) return 0;
+    report("״ν", start);
+
+    start = clock();
+    if (!name_index_rebuild()) return 0;
+    report("ٴν¼أ", start);
+
+    start = clock();
+    for (int i = 0; i < count; i += 2) {         /* һԱɾ */
+        PlayerHandle handle = player_store_handle_of(&player_store.records[i]);
+        const char* name = player_store_get(handle)->name;
+        name_index_remove(name, handle);
+        if (!name_index_insert(name, handle)) return 0;
+    }
+    report("һԱעٵǼ", start);
+
+    name_index_release();                        /* ַʽӿʼ */
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : DEFAULT_PLAYERS;
+    if (count <= 0 || !player_store_reserve(count)) {
+        printf("ڴ治ԱЧ\n");
+        return 1;
+    }
+    for (int i = 0; i < count; i++) {
+        Player player;
+        memset(&player, 0, sizeof(player));
+        player.id_key = (uint64_t)(202400000000LL + i);
+        snprintf(player.id, sizeof(player.id), "2024%08u", (unsigned)i % 100000000u);
+        snprintf(player.name, sizeof(player.name), "Player %d", i);
+        player.position = POSITION_SF;
+        player.height = 180;
+        player.weight = 75;
+        if (player_store_append(&player) == NULL) {
+            printf("ڴ治\n");
+            return 1;
+        }
+    }
+
+    printf("Ա %d\n", count);
+    printf("%-28s %-12s %10s %10s %10s\n", "", "䷽ʽ", "", "ͷŴ", "ʱ(s)");
+    for (use_pool = 1; use_pool >= 0; use_pool--) {
+        if (!run_steps(count)) {
+            printf("ڴ治\n");
+            return 1;
+        }
+    }
+
+    player_store_release();
+    return 0;
+}
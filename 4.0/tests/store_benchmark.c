@@ -0,0 +1,202 @@
+/*
+ * ============================================================================
+ * ׼ԣ洢ԭıҺʱԱ
+ * һĶǰĽṹ壨ÿԱһmallocnextָ룩ڱļؽ
+ * һֱʹplayer_storeģ飻װͬԱ
+ *     ۼȫԱߣظܺʱ0.2ȡƽ
+ *     ѧstrcmpԲңĶǰsearch_player_by_id㷨
+ *           ѧ1000ȡƽڵsearch_player_by_idùϣڴ˱Ƚ
+ * У4.0Ŀ¼£
+ *   gcc -std=c99 -O2 -o tests/store_benchmark.exe tests/store_benchmark.c player_store.c
+ *   tests\store_benchmark.exe [Ա ...]      Ĭ10000100000010000000
+ * 10000000ʱ鹲Լ1.6GBڴ棬32λͨ벻ʾڴ治
+ * еҪȽʮڴѧţĬϵйԼ
+ * ============================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../data_struct.h"
+#include "../player_store.h"
+
+#define MIN_SECONDS 0.2                          /* ÿۼƵ */
+#define LOOKUP_COUNT 1000                        /* ҲѧŸ */
+
+/*
+ * Ķǰڵ㣨ͬ1.0-4.0Playerṹ壩
+ */
+typedef struct ListNode {
+    char id[13];
+    char name[21];
+    char team[31];
+    char position[11];
+    int height;
+    int weight;
+    int jersey;
+    struct ListNode* next;
+} ListNode;
+
+static ListNode* list_head = NULL;               /* ͷ */
+static volatile long long sink = 0;              /* ֹɾȥѭ */
+
+/*
+ * make_id
+ * ܣɵiԱ12λѧ
+ */
+static void make_id(char* id, int i) {
+    snprintf(id, 13, "2024%08u", (unsigned)i % 100000000u);
+}
+
+/*
+ * fill_players
+ * ܣ洢װcountͬԱ
+ * ֵ1ʾɹ0ʾڴ治
+ */
+static int fill_players(int count) {
+    ListNode* tail = NULL;
+    if (!player_store_reserve(count)) {
+        return 0;
+    }
+    for (int i = 0; i < count; i++) {
+        ListNode* node = (ListNode*)calloc(1, sizeof(ListNode));
+        if (node == NULL) {
+            return 0;
+        }
+        make_id(node->id, i);
+        snprintf(node->name, sizeof(node->name), "Player %d", i);
+        strcpy(node->team, "Test");
+        strcpy(node->position, "SF");
+        node->height = 160 + i % 60;
+        node->weight = 60 + i % 50;
+        node->jersey = i % 100;
+        if (tail == NULL) {                      /* ԭһ׷ӵĩβ */
+            list_head = node;
+        } else {
+            tail->next = node;
+        }
+        tail = node;
+
+        Player player;
+        memset(&player, 0, sizeof(player));
+        memcpy(player.id, node->id, sizeof(player.id));
+        memcpy(player.name, node->name, sizeof(player.name));
+        player.id_key = (uint64_t)(202400000000LL + i);
+        player.position = POSITION_SF;
+        player.height = node->height;
+        player.weight = node->weight;
+        player.jersey = node->jersey;
+        if (player_store_append(&player) == NULL) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*
+ * free_players
+ * ܣͷ洢
+ */
+static void free_players(void) {
+    while (list_head != NULL) {
+        ListNode* next = list_head->next;
+        free(list_head);
+        list_head = next;
+    }
+    player_store_release();
+}
+
+/*
+ * scan_list / scan_store
+ * ܣ˳ȫԱۼ
+ */
+static void scan_list(void) {
+    long long sum = 0;
+    for (const ListNode* node = list_head; node != NULL; node = node->next) {
+        sum += node->height;
+    }
+    sink += sum;
+}
+
+static void scan_store(void) {
+    long long sum = 0;
+    for (int i = 0; i < player_store.count; i++) {
+        sum += player_store.records[i].height;
+    }
+    sink += sum;
+}
+
+static const char* lookup_ids[LOOKUP_COUNT];     /* ֲҵѧ */
+static char lookup_buffer[LOOKUP_COUNT][13];
+
+/*
+ * lookup_list / lookup_store
+ * ܣlookup_idsеѧţԲң
+ */
+static void lookup_list(void) {
+    for (int k = 0; k < LOOKUP_COUNT; k++) {
+        for (const ListNode* node = list_head; node != NULL; node = node->next) {
+            if (strcmp(node->id, lookup_ids[k]) == 0) {
+                sink += node->jersey;
+                break;
+            }
+        }
+    }
+}
+
+static void lookup_store(void) {
+    for (int k = 0; k < LOOKUP_COUNT; k++) {
+        for (int i = 0; i < player_store.count; i++) {
+            if (strcmp(player_store.records[i].id, lookup_ids[k]) == 0) {
+                sink += player_store.records[i].jersey;
+                break;
+            }
+        }
+    }
+}
+
+/*
+ * measure_ms
+ * ܣظеۼMIN_SECONDSϣÿεƽ
+ */
+static double measure_ms(void (*run)(void)) {
+    int rounds = 0;
+    clock_t start = clock();
+    clock_t elapsed;
+    do {
+        run();
+        rounds++;
+        elapsed = clock() - start;
+    } while ((double)elapsed / CLOCKS_PER_SEC < MIN_SECONDS);
+    return (double)elapsed * 1000.0 / CLOCKS_PER_SEC / rounds;
+}
+
+int main(int argc, char* argv[]) {
+    static const int default_counts[] = {10000, 1000000, 10000000};
+    int runs = argc > 1 ? argc - 1 : (int)(sizeof(default_counts) / sizeof(default_counts[0]));
+
+    printf("%10s %14s %14s %14s %14s\n", "Ա", "(ms)", "(ms)",
+           "(ms)", "(ms)");
+    for (int r = 0; r < runs; r++) {
+        int count = argc > 1 ? atoi(argv[r + 1]) : default_counts[r];
+        if (count <= 0 || !fill_players(count)) {
+            printf("%10d ڴ治ԱЧ\n", count);
+            free_players();
+            continue;
+        }
+        srand(12345);
+        for (int k = 0; k < LOOKUP_COUNT; k++) {
+            make_id(lookup_buffer[k], (int)(((long long)rand() * (RAND_MAX + 1LL) + rand()) % count));
+            lookup_ids[k] = lookup_buffer[k];
+        }
+        double list_scan = measure_ms(scan_list);
+        double store_scan = measure_ms(scan_store);
+        double list_lookup = measure_ms(lookup_list) / LOOKUP_COUNT;
+        double store_lookup = measure_ms(lookup_store) / LOOKUP_COUNT;
+        printf("%10d %14.3f %14.3f %14.3f %14.3f\n", count, list_scan, store_scan,
+               list_lookup, store_lookup);
+        free_players();
+    }
+    return 0;
+}
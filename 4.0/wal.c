@@ -0,0 +1,513 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <io.h>
+#include <windows.h>
+#include "data_struct.h"
+#include "file_format.h"
+#include "file_ops.h"
+#include "team_pool.h"
+#include "player_manager.h"
+#include "wal.h"
+
+#define WAL_MAGIC "PLAYRWAL"             /* ־ͷħ8ֽڲ */
+#define WAL_VERSION 1                    /* ־ʽ汾 */
+#define WAL_PUT 1                        /* ־ͣԱ״̬ */
+#define WAL_DELETE 2                     /* ־ͣɾ */
+#define WAL_RECORD_OFFSET 8              /* ־¼Ա¼ƫ */
+#define WAL_TEAM_OFFSET (WAL_RECORD_OFFSET + PLAYER_FILE_RECORD_SIZE)   /* Ƶƫ */
+
+static FILE* wal_file = NULL;            /* Ѵ򿪵־ļNULLʾδ */
+static char wal_path[260];               /* ־ļʱ´ */
+static int wal_entries = 0;              /* ־еļ¼ */
+static int wal_failed = 0;               /* ϴǷдʧ */
+static int wal_unsynced = 0;             /* ׷ӵδ̵ļ¼ */
+static DWORD wal_unsynced_since = 0;     /* һδ̼¼׷ʱ */
+static long wal_discarded = 0;           /* ϴδʱȥĲȱβֽ */
+
+/*
+ * ߳Լ߳׷ӡ򿪡աر־Զ̣߳autosave.hֻ̡
+ * wal_lock־ļָֻݳУ
+ * sync_lockͬڼУر־ļ֮ǰȡ
+ * ˵ȴʱ߳Կ׷ӡsync_lockwal_lock
+ */
+static CRITICAL_SECTION wal_lock;
+static CRITICAL_SECTION sync_lock;
+static int locks_ready = 0;              /* ״ʹʱ̳߳ʼ */
+
+/*
+ * lock_log / unlock_log
+ * ܣȡûͷر־ļʱʹã
+ */
+static void lock_log(void) {
+    if (!locks_ready) {
+        InitializeCriticalSection(&wal_lock);
+        InitializeCriticalSection(&sync_lock);
+        locks_ready = 1;
+    }
+    EnterCriticalSection(&sync_lock);
+    EnterCriticalSection(&wal_lock);
+}
+
+static void unlock_log(void) {
+    LeaveCriticalSection(&wal_lock);
+    LeaveCriticalSection(&sync_lock);
+}
+
+/*
+ * put_u32 / get_u32
+ * ܣСд32λ
+ */
+static void put_u32(unsigned char* p, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static uint32_t get_u32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/*
+ * entry_checksum
+ * ܣ־¼УֵУֵֶΰ0㣩
+ */
+static uint32_t entry_checksum(const unsigned char* entry) {
+    unsigned char copy[WAL_ENTRY_SIZE];
+    memcpy(copy, entry, WAL_ENTRY_SIZE);
+    put_u32(copy + 4, 0);
+    return file_format_checksum(copy, WAL_ENTRY_SIZE);
+}
+
+/*
+ * write_header
+ * ܣļͷд־ͷ
+ */
+static int write_header(FILE* file_ptr) {
+    unsigned char header[WAL_HEADER_SIZE];
+    memset(header, 0, sizeof(header));
+    memcpy(header, WAL_MAGIC, 8);
+    put_u32(header + 8, WAL_VERSION);
+    put_u32(header + 12, WAL_ENTRY_SIZE);
+    return fseek(file_ptr, 0, SEEK_SET) == 0 &&
+           fwrite(header, sizeof(header), 1, file_ptr) == 1 && fflush(file_ptr) == 0;
+}
+
+/*
+ * apply_entry
+ * ܣһ־¼Ӧõ洢
+ * ˵PUTѧд룬DELETEѧɾظӦýͬ
+ */
+static void apply_entry(const unsigned char* entry) {
+    Player player;
+    file_format_decode_record(entry + WAL_RECORD_OFFSET, &player);
+    if (entry[0] == WAL_DELETE) {
+        delete_player_by_key(player.id_key);
+        return;
+    }
+    char team[PLAYER_FILE_TEAM_ENTRY_SIZE];     /* ưµǼ */
+    memcpy(team, entry + WAL_TEAM_OFFSET, sizeof(team));
+    team[sizeof(team) - 1] = '\0';
+    if (!pack_player_id(player.id, &player.id_key) || !validate_player_fields(&player)) {
+        return;                                 /* ѧŻֶ𻵣ռӱ */
+    }
+    int team_id = team_pool_intern(team);
+    if (team_id < 0) {
+        return;                                 /* ӱþ */
+    }
+    player.team_id = (uint16_t)team_id;
+    put_player_record(&player);
+}
+
+/*
+ * replay_stream
+ * ܣļͷȡӦȫ־¼
+ * file_ptr - ־ļ, valid_end - һ¼֮ƫƣļΪ0
+ * ֵӦõļ¼־ͷ޷ʶ𷵻-1
+ */
+static int replay_stream(FILE* file_ptr, long* valid_end) {
+    unsigned char header[WAL_HEADER_SIZE];
+    *valid_end = 0;
+    if (fseek(file_ptr, 0, SEEK_SET) != 0) return -1;
+    size_t got = fread(header, 1, sizeof(header), file_ptr);
+    if (got == 0) {
+        return 0;                               /* ļ־ͷ */
+    }
+    if (got < sizeof(header) || memcmp(header, WAL_MAGIC, 8) != 0 ||
+        get_u32(header + 8) != WAL_VERSION || get_u32(header + 12) != WAL_ENTRY_SIZE) {
+        return -1;                              /* Ǳ־ļ */
+    }
+    
+    unsigned char entry[WAL_ENTRY_SIZE];
+    int applied = 0;
+    *valid_end = WAL_HEADER_SIZE;
+    while (fread(entry, WAL_ENTRY_SIZE, 1, file_ptr) == 1) {
+        if ((entry[0] != WAL_PUT && entry[0] != WAL_DELETE) ||
+            get_u32(entry + 4) != entry_checksum(entry)) {
+            break;                              /* ȱ¼һɺ */
+        }
+        apply_entry(entry);
+        applied++;
+        *valid_end += WAL_ENTRY_SIZE;
+    }
+    return applied;
+}
+
+/*
+ * wal_replay
+ * ܣ־ļеȫ¼˳Ӧõǰ洢־д룩
+ * path - ־ļ
+ * ֵӦõ־¼־ڷ0־ͷ޷ʶ𷵻-1
+ */
+int wal_replay(const char* path) {
+    FILE* file_ptr = fopen(path, "rb");
+    if (file_ptr == NULL) {
+        return 0;                               /* û־ */
+    }
+    long valid_end;
+    int applied = replay_stream(file_ptr, &valid_end);
+    fclose(file_ptr);
+    return applied;
+}
+
+/*
+ * wal_pending
+ * ܣж־ļǷδļļ¼
+ * path - ־ļ
+ * ֵ1ʾһ¼0ʾ־ڻΪ
+ */
+int wal_pending(const char* path) {
+    FILE* file_ptr = fopen(path, "rb");
+    if (file_ptr == NULL) {
+        return 0;
+    }
+    int pending = fseek(file_ptr, 0, SEEK_END) == 0 &&
+                  ftell(file_ptr) >= WAL_HEADER_SIZE + WAL_ENTRY_SIZE;
+    fclose(file_ptr);
+    return pending;
+}
+
+/*
+ * open_log
+ * ܣ򿪲ط־߳
+ */
+static void close_log(void);
+
+static int open_log(const char* path) {
+    close_log();
+    FILE* file_ptr = fopen(path, "r+b");        /* ־дʽ */
+    if (file_ptr == NULL) {
+        file_ptr = fopen(path, "w+b");          /* ½־ */
+    }
+    if (file_ptr == NULL) {
+        return -1;
+    }
+    
+    long valid_end;
+    int applied = replay_stream(file_ptr, &valid_end);
+    if (applied < 0) {
+        fclose(file_ptr);                       /* ޷ʶļ */
+        return -1;
+    }
+    if (valid_end == 0) {                       /* ļд־ͷ */
+        if (!write_header(file_ptr)) {
+            fclose(file_ptr);
+            return -1;
+        }
+        valid_end = WAL_HEADER_SIZE;
+    }
+    if (fseek(file_ptr, 0, SEEK_END) != 0) {
+        fclose(file_ptr);
+        return -1;
+    }
+    long discarded = ftell(file_ptr) - valid_end;
+    if (discarded > 0 &&                        /* ȥȱ¼ݣ¼¼֮¶ɼ¼ */
+        (fflush(file_ptr) != 0 || _chsize(_fileno(file_ptr), valid_end) != 0)) {
+        fclose(file_ptr);                       /* ضʧʱ׷ */
+        return -1;
+    }
+    if (fseek(file_ptr, valid_end, SEEK_SET) != 0) {   /* ¼֮׷ */
+        fclose(file_ptr);
+        return -1;
+    }
+    
+    wal_file = file_ptr;
+    strncpy(wal_path, path, sizeof(wal_path) - 1);
+    wal_path[sizeof(wal_path) - 1] = '\0';
+    wal_entries = applied;
+    wal_failed = 0;
+    wal_unsynced = 0;
+    wal_discarded = discarded > 0 ? discarded : 0;
+    return applied;
+}
+
+/*
+ * wal_open
+ * ܣط־ļ󱣳ִ򿪣˺ĸĶ׷ӵһ¼֮
+ * path - ־ļʱ½
+ * ֵطŵ־¼־ͷ޷ʶļ޷޷ضϷ-1
+ * ˵һȱ¼ݶȥֽwal_discarded_bytes
+ */
+int wal_open(const char* path) {
+    lock_log();
+    int applied = open_log(path);
+    unlock_log();
+    return applied;
+}
+
+/*
+ * append_entry
+ * ܣ׷һ־¼ϵͳ̱ᶪʧ
+ */
+static int append_entry(int type, const Player* player) {
+    if (wal_file == NULL) {
+        return 1;                               /* ־δ */
+    }
+    unsigned char entry[WAL_ENTRY_SIZE];
+    memset(entry, 0, sizeof(entry));
+    entry[0] = (unsigned char)type;
+    file_format_encode_record(player, entry + WAL_RECORD_OFFSET);
+    if (type == WAL_PUT) {
+        strncpy((char*)entry + WAL_TEAM_OFFSET, team_pool_name(player->team_id),
+                PLAYER_FILE_TEAM_ENTRY_SIZE - 1);
+    }
+    put_u32(entry + 4, entry_checksum(entry));
+    
+    EnterCriticalSection(&wal_lock);            /* ־Ѵ򿪣ѳʼ */
+    int ok = fwrite(entry, sizeof(entry), 1, wal_file) == 1 && fflush(wal_file) == 0;
+    if (!ok) {
+        wal_failed = 1;                         /* ʱΪдļ */
+    } else {
+        wal_entries++;
+        if (wal_unsynced++ == 0) {
+            wal_unsynced_since = GetTickCount();    /* µһӴ˿ʼʱ */
+        }
+    }
+    LeaveCriticalSection(&wal_lock);
+    return ok;
+}
+
+/*
+ * wal_log_put
+ * ܣ¼һԱ״̬ӻ޸֮ã
+ * player - ĶԱ¼
+ * ֵ1ʾдɹ־δ򿪣0ʾдʧ
+ */
+int wal_log_put(const Player* player) {
+    return append_entry(WAL_PUT, player);
+}
+
+/*
+ * wal_log_delete
+ * ܣ¼һɾɾ֮ã
+ * id_key - ɾԱѧ
+ * ֵ1ʾдɹ־δ򿪣0ʾдʧ
+ */
+int wal_log_delete(uint64_t id_key) {
+    Player player;
+    memset(&player, 0, sizeof(player));
+    player.id_key = id_key;                     /* ɾ¼ֻѧ */
+    return append_entry(WAL_DELETE, &player);
+}
+
+/*
+ * sync_entries
+ * ܣδ̼¼ﵽmin_entriesһѵȴmax_wait_msʱ־ͬ
+ * ֵ1ʾϴȫ¼ѽ̻ݲҪͬ0ʾм¼дʧܣ
+ *         -1ʾ־δ
+ * ˵߳sync_lockȴڼ䲻wal_lock߳ճ׷ӣ
+ *       ͬڼ׷ӵļ¼һ
+ */
+static int sync_entries(int min_entries, DWORD max_wait_ms) {
+    EnterCriticalSection(&wal_lock);
+    if (wal_file == NULL) {
+        LeaveCriticalSection(&wal_lock);
+        return -1;
+    }
+    int pending = wal_unsynced;                 /* Ҫͬļ¼ */
+    int due = pending > 0 && (pending >= min_entries ||
+                              GetTickCount() - wal_unsynced_since >= max_wait_ms);
+    int ok = !due || fflush(wal_file) == 0;
+    int fd = _fileno(wal_file);
+    LeaveCriticalSection(&wal_lock);
+    
+    if (due && ok) {
+        ok = _commit(fd) == 0;                  /* ȴ */
+    }
+    
+    EnterCriticalSection(&wal_lock);
+    if (due) {
+        wal_unsynced -= pending;
+        if (wal_unsynced > 0) {
+            wal_unsynced_since = GetTickCount();
+        }
+        if (!ok) {
+            wal_failed = 1;
+        }
+    }
+    int result = !wal_failed;
+    LeaveCriticalSection(&wal_lock);
+    return result;
+}
+
+/*
+ * wal_commit
+ * ܣ׷ӵ־¼ˢµ
+ * 
+ * ֵ1ʾϴȫ¼̣
+ *         0ʾ־δûм¼дʧܣʱļ
+ */
+int wal_commit(void) {
+    if (!locks_ready) {
+        return 0;                               /* δ򿪹־ */
+    }
+    EnterCriticalSection(&sync_lock);           /* Զ̵߳ͬ */
+    int result = sync_entries(1, 0);
+    LeaveCriticalSection(&sync_lock);
+    return result == 1;
+}
+
+/*
+ * wal_commit_group
+ * ܣ̣δ̵ļ¼㹻ѵȴ㹻ʱˢµ
+ * min_entries - δ̼¼ﵽ, max_wait_ms - һȴú
+ * ֵ1ʾ̡ݲҪ̻־δã0ʾм¼дʧ
+ * ˵Զ߳е
+ */
+int wal_commit_group(int min_entries, int max_wait_ms) {
+    if (!locks_ready) {
+        return 1;
+    }
+    EnterCriticalSection(&sync_lock);
+    int result = sync_entries(min_entries, (DWORD)max_wait_ms);
+    LeaveCriticalSection(&sync_lock);
+    return result != 0;
+}
+
+/*
+ * reset_log
+ * ܣ־߳
+ */
+static int reset_log(void) {
+    if (wal_file == NULL) {
+        return 1;                               /* ־δ */
+    }
+    fclose(wal_file);
+    wal_file = fopen(wal_path, "w+b");          /* ضΪļ */
+    if (wal_file == NULL || !write_header(wal_file)) {
+        if (wal_file != NULL) fclose(wal_file);
+        wal_file = NULL;                        /* ־ã˺ÿαд */
+        return 0;
+    }
+    wal_entries = 0;
+    wal_failed = 0;
+    wal_unsynced = 0;
+    return 1;
+}
+
+/*
+ * wal_reset
+ * ܣ־ļ֮ã
+ * 
+ * ֵ1ʾɹ0ʾʧ
+ */
+int wal_reset(void) {
+    lock_log();
+    int ok = reset_log();
+    unlock_log();
+    return ok;
+}
+
+/*
+ * rotate_log
+ * ܣǰ־½־߳
+ */
+static int rotate_log(const char* rotated_path) {
+    if (wal_file == NULL || wal_failed || fflush(wal_file) != 0) {
+        return 0;                               /* м¼ʧֻ־ָ */
+    }
+    fclose(wal_file);
+    if (rename(wal_path, rotated_path) != 0) {
+        wal_file = fopen(wal_path, "r+b");      /* ʧܣصԭ־ĩβ */
+        if (wal_file == NULL || fseek(wal_file, 0, SEEK_END) != 0) {
+            if (wal_file != NULL) fclose(wal_file);
+            wal_file = NULL;
+        }
+        return 0;
+    }
+    wal_file = fopen(wal_path, "w+b");
+    if (wal_file == NULL || !write_header(wal_file)) {
+        if (wal_file != NULL) fclose(wal_file);
+        wal_file = NULL;                        /* ־ã˺ÿαд */
+    }
+    wal_entries = 0;
+    wal_failed = 0;
+    wal_unsynced = 0;
+    return 1;
+}
+
+/*
+ * wal_rotate
+ * ܣѵǰ־Ϊrotated_path½־׷
+ * rotated_path - ļ벻ڣ
+ * ֵ1ʾɹ0ʾδ־δáм¼дʧܻʧܣ
+ * ˵ǰȰ־̣ʧʱԭ־´򿪣ճʹ
+ */
+int wal_rotate(const char* rotated_path) {
+    lock_log();
+    int ok = rotate_log(rotated_path);
+    unlock_log();
+    return ok;
+}
+
+/*
+ * wal_entry_count
+ * ܣȡ־еļ¼طŵ׷ӵģ
+ * 
+ * ֵ¼־δ򿪷0
+ */
+int wal_entry_count(void) {
+    if (!locks_ready) {
+        return 0;
+    }
+    EnterCriticalSection(&wal_lock);
+    int count = wal_file != NULL ? wal_entries : 0;
+    LeaveCriticalSection(&wal_lock);
+    return count;
+}
+
+/*
+ * wal_discarded_bytes
+ * ܣȡϴwal_openʱȥĲȱβֽ
+ * 
+ * ֵȥֽ־ʱΪ0
+ */
+long wal_discarded_bytes(void) {
+    return wal_discarded;
+}
+
+/*
+ * close_log
+ * ܣˢ²ر־߳
+ */
+static void close_log(void) {
+    if (wal_file != NULL) {
+        fflush(wal_file);
+        fclose(wal_file);
+        wal_file = NULL;
+    }
+    wal_entries = 0;
+    wal_failed = 0;
+    wal_unsynced = 0;
+}
+
+/*
+ * wal_close
+ * ܣˢ²ر־
+ * 
+ */
+void wal_close(void) {
+    lock_log();
+    close_log();
+    unlock_log();
+}
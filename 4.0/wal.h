@@ -0,0 +1,137 @@
+#ifndef WAL_H
+#define WAL_H
+
+#include <stdint.h>
+#include "data_struct.h"
+
+/*
+ * Ԥд־ģ飨write-ahead log
+ * ÿӡ޸ġɾԱ־ļĩβ׷һ־¼
+ * ֻ־ˢµ̣ʱĶȣдļ
+ * ʱȶȡļգٰ˳ط־ָһθĶ״̬
+ *
+ * ־ļ = [־ͷ 16ֽ] +  [־¼ 104ֽ]
+ *   ־ͷħ"PLAYRWAL"汾š¼С
+ *   ־¼(1ֽ) + (3ֽ) + Уֵ(4ֽ)
+ *             + Ա¼(64ֽڣͬļ) + (32ֽ)
+ * д룺Ա״̬(PUT)ɾѧ(DELETE)طνͬ
+ * ;ʱĩβܲ¼طУ鲻ļ¼ֹͣ
+ * ־ʱ¼ȫݽȥ֮׷Ӵһ¼֮ʼ
+ * ֻǲضʱ¼¼֮ľɼ¼´λ±طţ
+ */
+
+#define WAL_HEADER_SIZE 16               /* ־ͷֽ */
+#define WAL_ENTRY_SIZE 104               /* ÿ־¼ֽ */
+#define WAL_GROUP_COMMIT_ENTRIES 64      /* Ĭֵδ̼¼ﵽ */
+#define WAL_GROUP_COMMIT_MS 1000         /* Ĭֵһδ̼¼ȴú */
+
+/*
+ * 
+ * кϸĲ˵͹
+ */
+
+/*
+ * wal_replay
+ * ܣ־ļеȫ¼˳Ӧõǰ洢־д룩
+ * path - ־ļ
+ * ֵӦõ־¼־ڷ0־ͷ޷ʶ𷵻-1
+ */
+int wal_replay(const char* path);
+
+/*
+ * wal_pending
+ * ܣж־ļǷδļļ¼
+ * path - ־ļ
+ * ֵ1ʾһ¼0ʾ־ڻΪ
+ */
+int wal_pending(const char* path);
+
+/*
+ * wal_open
+ * ܣط־ļ󱣳ִ򿪣˺ĸĶ׷ӵһ¼֮
+ * path - ־ļʱ½
+ * ֵطŵ־¼־ͷ޷ʶļ޷޷ضϷ-1
+ * ˵ڼļ֮ãδ־ʱд־κ
+ */
+int wal_open(const char* path);
+
+/*
+ * wal_discarded_bytes
+ * ܣȡϴwal_openʱȥĲȱβֽ
+ * 
+ * ֵȥֽ־ʱΪ0
+ */
+long wal_discarded_bytes(void);
+
+/*
+ * wal_log_put
+ * ܣ¼һԱ״̬ӻ޸֮ã
+ * player - ĶԱ¼
+ * ֵ1ʾдɹ־δ򿪣0ʾдʧ
+ */
+int wal_log_put(const Player* player);
+
+/*
+ * wal_log_delete
+ * ܣ¼һɾɾ֮ã
+ * id_key - ɾԱѧ
+ * ֵ1ʾдɹ־δ򿪣0ʾдʧ
+ */
+int wal_log_delete(uint64_t id_key);
+
+/*
+ * wal_commit
+ * ܣ׷ӵ־¼ˢµ
+ * 
+ * ֵ1ʾϴȫ¼̣
+ *         0ʾ־δûм¼дʧܣʱļ
+ */
+int wal_commit(void);
+
+/*
+ * wal_commit_group
+ * ܣ̣δ̵ļ¼㹻ѵȴ㹻ʱˢµ
+ * min_entries - δ̼¼ﵽ, max_wait_ms - һȴú
+ * ֵ1ʾ̡ݲҪ̻־δã0ʾм¼дʧܣʱļ
+ * ˵θĶϲΪһδͬԶ̶߳ڵãautosave.h
+ *       ÿ¼׷ʱѽϵͳ̱ᶪʧϵඪʧһĶ
+ *       Ҫ־ûʱûѡ񱣴棩wal_commit
+ *       wal_commit̵߳ãຯ̵ֻ߳ãͬڼ̵߳׷Ӳ
+ */
+int wal_commit_group(int min_entries, int max_wait_ms);
+
+/*
+ * wal_reset
+ * ܣ־ļ֮ã
+ * 
+ * ֵ1ʾɹ0ʾʧ
+ */
+int wal_reset(void);
+
+/*
+ * wal_rotate
+ * ܣѵǰ־Ϊrotated_path½־׷
+ * rotated_path - ļ벻ڣ
+ * ֵ1ʾɹ0ʾδ־δáм¼дʧܻʧܣ
+ * ˵̨ѿյĸĶ˺ĸĶֿcheckpoint.h
+ *       ʱطŸ־طŵǰ־
+ *       ǰֻѼ¼ϵͳȴ̣ɵں̨Ѹ־
+ */
+int wal_rotate(const char* rotated_path);
+
+/*
+ * wal_entry_count
+ * ܣȡ־еļ¼طŵ׷ӵģ
+ * 
+ * ֵ¼־δ򿪷0
+ */
+int wal_entry_count(void);
+
+/*
+ * wal_close
+ * ܣˢ²ر־
+ * 
+ */
+void wal_close(void);
+
+#endif /* WAL_H */